@@ -1,4 +1,6 @@
 #include "RNSwisseph.h"
+#include <cstring>
+#include <stdexcept>
 
 namespace swisseph {
 double swe_julday(int year, int month, int day, double hour, int gregflag) {
@@ -167,6 +169,13 @@ std::map<std::string, double> swe_fixstar_ut(const std::string &star, double tjd
 }
 
 
+const char *const kHeliacalPhenoKeys[kHeliacalPhenoCount] = {
+    "tcAltitude", "tcApparentAltitude", "gcAltitude", "azimuth", "tcSunAltitude", "sunAzimuth",
+    "tcActualVisibleArc", "gcActualVisibleArc", "objectToSunAzimuth", "objectToSunLongitude", "extinction",
+    "tcMinVisibleArc", "firstVisible", "bestVisible", "endVisible", "yallopBestVisible", "moonCresentWidth",
+    "yallopValue", "yallopCriterion", "parallax", "magnitude", "rise", "riseSet", "riseObjectToSun",
+    "visibleDuration", "moonCresetLength", "elong", "illumination", "kOZ", "ka", "ksumm"};
+
 std::vector<double> swe_heliacal_pheno_ut(double tjd_ut, std::vector<double> dgeo, std::vector<double> datm, std::vector<double> dobs, const std::string& object_name, int event_type, int helflag) {
   double darr[50];
   char serr[AS_MAXCH];
@@ -176,7 +185,7 @@ std::vector<double> swe_heliacal_pheno_ut(double tjd_ut, std::vector<double> dge
 
   int32 result = ::swe_heliacal_pheno_ut(tjd_ut, dgeo.data(), datm.data(), dobs.data(), name, event_type, helflag, darr, serr);
 
-  std::vector<double> ret(darr, darr + 31);
+  std::vector<double> ret(darr, darr + kHeliacalPhenoCount);
   ret.insert(ret.begin(), result);
   return ret;
 }
@@ -219,6 +228,53 @@ void swe_close() {
   ::swe_close();
 }
 
+// Caps the memory that the calling thread (each JS runtime and each batch
+// worker has its own) allocates for ephemeris data; 0 removes the cap.
+void swe_set_memory_limit(int nbytes) {
+  ::swe_set_memory_limit(nbytes);
+}
+
+std::map<std::string, double> swe_get_memory_stats() {
+  int32 stats[6];
+  std::map<std::string, double> ret;
+  ret["limit"] = ::swe_get_memory_stats(stats);
+  ret["total"] = stats[0];
+  ret["segments"] = stats[1];
+  ret["nutation"] = stats[2];
+  ret["fileBuffers"] = stats[3];
+  ret["openFiles"] = stats[4];
+  ret["fixed"] = stats[5];
+  return ret;
+}
+
+// Hot path counters and timers of the calling thread, including the batch
+// workers it started. All zero, with enabled = 0, unless the library is
+// compiled with SWE_STATS.
+std::map<std::string, double> swe_get_stats() {
+  static const char *counters[SE_NSTAT_COUNTERS] = {
+    "segments", "fileOpens", "readBytes", "nutation", "obliquity",
+    "savedHits", "starScans", "riseSteps", "eclipseSteps",
+  };
+  static const char *timers[SE_NSTAT_TIMERS] = {
+    "calc", "segmentReads", "fixstar", "houses", "riseTrans", "eclipse", "heliacal",
+  };
+  double count[SE_NSTAT_COUNTERS], timer[2 * SE_NSTAT_TIMERS];
+  std::map<std::string, double> ret;
+  ret["enabled"] = ::swe_get_stats(count, timer) == OK;
+  for (int i = 0; i < SE_NSTAT_COUNTERS; i++) {
+    ret[counters[i]] = count[i];
+  }
+  for (int i = 0; i < SE_NSTAT_TIMERS; i++) {
+    ret[std::string(timers[i]) + "Calls"] = timer[2 * i];
+    ret[std::string(timers[i]) + "Seconds"] = timer[2 * i + 1];
+  }
+  return ret;
+}
+
+void swe_reset_stats() {
+  ::swe_reset_stats();
+}
+
 std::string getPath(){
   return swed.ephepath;
 }
@@ -10,6 +10,25 @@ extern "C" {
 #include <vector>
 
 namespace swisseph {
+  // Heliacal events of catalog stars: `events` holds dense arrays, its "star"
+  // entries index `stars` and `magnitudes`.
+  struct HeliacalCalendar {
+    std::vector<std::string> stars;
+    std::vector<double> magnitudes;
+    std::map<std::string, std::vector<double>> events;
+  };
+
+  // Lunar occultations found by one sweep: `events` holds dense arrays, its
+  // "target" entries index `targets`.
+  struct OccultationScan {
+    std::vector<std::string> targets;
+    std::map<std::string, std::vector<double>> events;
+  };
+
+  // Names of darr[0..30] of swe_heliacal_pheno_ut().
+  constexpr int kHeliacalPhenoCount = 31;
+  extern const char *const kHeliacalPhenoKeys[kHeliacalPhenoCount];
+
   double swe_julday(int year, int month, int day, double hour, int gregflag);
   double swe_deltat(double tjd);
   std::tuple<int, int, int, double> swe_revjul(double julday, int gregflag);
@@ -35,6 +54,33 @@ namespace swisseph {
   std::vector<double> swe_heliacal_pheno_ut(double tjd_ut, std::vector<double> dgeo, std::vector<double> datm, std::vector<double> dobs, const std::string& object_name, int event_type, int helflag);
   std::vector<double> swe_heliacal_ut(double tjd_ut, std::vector<double> dgeo, std::vector<double> datm, std::vector<double> dobs, const std::string& object_name, int event_type, int helflag);
   std::vector<double> swe_vis_limit_mag(double tjd_ut, std::vector<double> dgeo, std::vector<double> datm, std::vector<double> dobs, const std::string& object_name, int helflag);
+  std::map<std::string, std::vector<double>> swe_transit_scan(const std::vector<double> &natal, const std::vector<int> &bodies, const std::vector<double> &aspects, const std::vector<double> &orbs, double tjd_start, double tjd_end, int iflag);
+  std::map<std::string, std::vector<double>> swe_lunations(double tjd_start, double tjd_end, const std::vector<double> &phases, int iflag);
+  std::map<std::string, std::vector<double>> swe_rise_trans_calendar(double tjd_start, int ndays, const std::vector<double> &geopos, const std::vector<int> &bodies, int epheflag, int rsmi, double atpress, double attemp);
+  std::map<std::string, std::vector<double>> swe_horizon_events(double tjd_start, double tjd_end, const std::vector<double> &geopos, const std::vector<int> &bodies, const std::vector<std::string> &stars, int epheflag, int rsmi, double atpress, double attemp);
+  std::map<std::string, std::vector<double>> swe_twilight_table(double tjd_start, int ndays, const std::vector<double> &geopos, int epheflag);
+  std::map<std::string, std::vector<double>> swe_gauquelin_sector_batch(const std::vector<double> &tjd_ut, const std::vector<double> &geopos, const std::vector<int> &bodies, int iflag, int imeth, double atpress, double attemp);
+  std::map<std::string, std::vector<double>> swe_vis_limit_mag_grid(double tjd_ut, std::vector<double> dgeo, std::vector<double> datm, std::vector<double> dobs, int helflag, const std::vector<double> &azimuths, const std::vector<double> &altitudes);
+  HeliacalCalendar swe_heliacal_calendar(double tjd_start, double tjd_end, std::vector<double> dgeo, std::vector<double> datm, std::vector<double> dobs, double maglimit, const std::vector<int> &events, int helflag);
+  std::map<std::string, std::vector<double>> swe_heliacal_pheno_batch(const std::vector<double> &tjd_ut, const std::vector<double> &geopos, std::vector<double> datm, std::vector<double> dobs, const std::string &object_name, int event_type, int helflag);
+  void swe_eclipse_catalog_build(const std::string &path, double tjd_start, double tjd_end, int iflag);
+  std::map<std::string, std::vector<double>> swe_eclipse_catalog_when(const std::string &file, double tjd_start, int body, int ifltype, bool backward);
+  std::map<std::string, std::vector<double>> swe_eclipse_catalog_range(const std::string &file, double tjd_start, double tjd_end, int body, int ifltype);
+  std::map<std::string, std::vector<double>> swe_sol_eclipse_map(double tjd_ut, int iflag, double lon_step, double lat_step);
+  OccultationScan swe_lun_occult_scan(double tjd_start, double tjd_end, const std::vector<int> &bodies, const std::vector<std::string> &stars, double maglimit, int iflag);
+  std::map<std::string, std::vector<double>> swe_eclipse_when_loc_batch(double tjd_ut, int body, const std::vector<double> &geopos, int iflag);
+  std::map<std::string, std::vector<double>> swe_pheno_batch(const std::vector<double> &tjd_ut, const std::vector<int> &bodies, int iflag);
+  std::map<std::string, std::vector<double>> swe_nod_aps_batch(const std::vector<double> &tjd_ut, const std::vector<int> &bodies, int iflag, const std::vector<int> &methods);
+  std::map<std::string, std::vector<double>> swe_lunar_osc_batch(const std::vector<double> &tjd_ut, int iflag);
+  std::map<std::string, std::vector<double>> swe_azalt_batch(const std::vector<double> &tjd_ut, int calc_flag, const std::vector<double> &geopos, double atpress, double attemp, const std::vector<double> &xin);
+  std::map<std::string, std::vector<double>> swe_azalt_rev_batch(const std::vector<double> &tjd_ut, int calc_flag, const std::vector<double> &geopos, const std::vector<double> &xin);
+  std::vector<double> swe_sidtime_batch(const std::vector<double> &tjd_ut);
+  std::vector<double> swe_sidtime0_batch(const std::vector<double> &tjd_ut, const std::vector<double> &eps, const std::vector<double> &nut);
+  std::vector<double> swe_time_equ_batch(const std::vector<double> &tjd_ut);
+  void swe_set_memory_limit(int nbytes);
+  std::map<std::string, double> swe_get_memory_stats();
+  std::map<std::string, double> swe_get_stats();
+  void swe_reset_stats();
   void swe_set_ephe_path(const char* path);
   void swe_close();
   std::string getPath();
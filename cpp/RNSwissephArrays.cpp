@@ -0,0 +1,411 @@
+#include "RNSwissephBatch.h"
+
+extern "C" {
+  #include "swephlib.h"
+}
+
+namespace swisseph {
+
+namespace {
+
+// Names of attr[0..5] of swe_pheno_ut().
+const char *const kPhenoKeys[] = {
+  "phaseAngle", "phase", "elongation", "diameter", "magnitude", "parallax",
+};
+
+// Transforms below this many positions stay on the calling thread.
+constexpr size_t kMinTransformChunk = 4096;
+
+// Rotation from the equatorial (or ecliptic, with eps != 0) frame of the
+// date to the horizon of an observer at latitude `lat`, whose meridian is at
+// right ascension `armc`: x to the south, y to the west, z to the zenith.
+struct HorizonRotation {
+  double m[3][3];
+
+  HorizonRotation(double armc, double lat, double eps) {
+    double sa = std::sin(armc * DEGTORAD), ca = std::cos(armc * DEGTORAD);
+    double sl = std::sin(lat * DEGTORAD), cl = std::cos(lat * DEGTORAD);
+    double se = std::sin(eps * DEGTORAD), ce = std::cos(eps * DEGTORAD);
+    // hour angle frame, y to the east: Rz(armc)
+    double h[3][3] = {{ca, sa, 0}, {-sa, ca, 0}, {0, 0, 1}};
+    // ecliptic to equatorial: Rx(-eps)
+    double e[3][3] = {{1, 0, 0}, {0, ce, -se}, {0, se, ce}};
+    // horizon: tilt by the colatitude, y to the west
+    double z[3][3] = {{sl, 0, -cl}, {0, -1, 0}, {cl, 0, sl}};
+    double he[3][3];
+    multiply(h, e, he);
+    multiply(z, he, m);
+  }
+
+  static void multiply(const double a[3][3], const double b[3][3], double c[3][3]) {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        c[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j];
+      }
+    }
+  }
+};
+
+// Unit vectors of n polar positions (degrees, 2 per position), as three
+// separate arrays so that the rotation loops below vectorize.
+struct UnitVectors {
+  std::vector<double> x, y, z;
+
+  void assign(const double *pol, size_t n) {
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    for (size_t i = 0; i < n; i++) {
+      double lon = pol[2 * i] * DEGTORAD, lat = pol[2 * i + 1] * DEGTORAD;
+      double cl = std::cos(lat);
+      x[i] = cl * std::cos(lon);
+      y[i] = cl * std::sin(lon);
+      z[i] = std::sin(lat);
+    }
+  }
+
+  // v = m * v, or the transpose of m with `inverse`
+  void rotate(const double m[3][3], bool inverse) {
+    double r[3][3];
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        r[i][j] = inverse ? m[j][i] : m[i][j];
+      }
+    }
+    double *px = x.data(), *py = y.data(), *pz = z.data();
+    for (size_t i = 0, n = x.size(); i < n; i++) {
+      double vx = px[i], vy = py[i], vz = pz[i];
+      px[i] = r[0][0] * vx + r[0][1] * vy + r[0][2] * vz;
+      py[i] = r[1][0] * vx + r[1][1] * vy + r[1][2] * vz;
+      pz[i] = r[2][0] * vx + r[2][1] * vy + r[2][2] * vz;
+    }
+  }
+};
+
+// Obliquity of the ecliptic as swe_azalt() gets it.
+double trueObliquity(double tjd_ut) {
+  double x[6];
+  ::swe_calc(tjd_ut + ::swe_deltat_ex(tjd_ut, -1, NULL), SE_ECL_NUT, 0, x, NULL);
+  return x[0];
+}
+
+// Calls fn(t, first, count) for each run of positions of one date among
+// [begin, end), where positions are date-major with `per` per date.
+template <typename Fn>
+void forEachDate(size_t begin, size_t end, size_t per, Fn fn) {
+  while (begin < end) {
+    size_t t = begin / per;
+    size_t stop = std::min(end, (t + 1) * per);
+    fn(t, begin, stop - begin);
+    begin = stop;
+  }
+}
+
+// Earth rotation angle per day in degrees (IERS Conventions 2010).
+constexpr double kEraRate = 360 * 1.00273781191135448;
+// Sidereal time and the equation of time are fitted over windows of one
+// UT day, [k - 0.5, k + 0.5), so that no window straddles a switch of
+// sidereal time model (swe_sidtime0() switches at 0h UT), ...
+constexpr int kDayNodes = 6;
+// ... but only for days with more dates than this; fewer are computed
+// one by one.
+constexpr size_t kMinDatesPerFit = 8;
+
+// Chebyshev interpolation of f over one UT day, at kDayNodes nodes.
+struct DayFit {
+  double day;
+  double coef[kDayNodes];
+
+  template <typename Fn>
+  DayFit(double day, Fn f) : day(day) {
+    double y[kDayNodes];
+    for (int k = 0; k < kDayNodes; k++) {
+      y[k] = f(day + 0.5 * std::cos(PI * (k + 0.5) / kDayNodes));
+    }
+    for (int j = 0; j < kDayNodes; j++) {
+      double sum = 0;
+      for (int k = 0; k < kDayNodes; k++) {
+        sum += y[k] * std::cos(PI * j * (k + 0.5) / kDayNodes);
+      }
+      coef[j] = sum * 2 / kDayNodes;
+    }
+  }
+
+  double operator()(double t) const {
+    return ::swi_echeb((t - day) * 2, const_cast<double *>(coef), kDayNodes);
+  }
+};
+
+// Evaluates `exact` for every date in `tjd_ut`, except that days with many
+// dates get a DayFit of `smooth` instead. `smooth` must be a smooth function
+// of time that `value` turns into the result.
+template <typename Exact, typename Smooth, typename Value>
+std::vector<double> evaluateByDay(const std::vector<double> &tjd_ut, Exact exact, Smooth smooth, Value value) {
+  std::map<double, std::vector<size_t>> days;
+  for (size_t i = 0; i < tjd_ut.size(); i++) {
+    days[std::floor(tjd_ut[i] + 0.5)].push_back(i);
+  }
+  std::vector<std::pair<double, const std::vector<size_t> *>> work;
+  for (const auto &d : days) {
+    work.push_back({d.first, &d.second});
+  }
+  std::vector<double> result(tjd_ut.size());
+  parallelFor(work.size(), workerCount(tjd_ut.size() / kMinTransformChunk), [&](size_t begin, size_t end, size_t) {
+    for (size_t w = begin; w < end; w++) {
+      const auto &dates = *work[w].second;
+      if (dates.size() < kMinDatesPerFit) {
+        for (size_t i : dates) {
+          result[i] = exact(tjd_ut[i]);
+        }
+        continue;
+      }
+      DayFit fit(work[w].first, smooth);
+      for (size_t i : dates) {
+        result[i] = value(tjd_ut[i], fit(tjd_ut[i]));
+      }
+    }
+  });
+  return result;
+}
+
+// Sidereal time in degrees minus the Earth rotation angle since the start
+// of the UT day of t, continuous within the day.
+double siderealOffset(double t, double sidtime) {
+  double day = std::floor(t + 0.5) - 0.5;
+  return ::swe_difdeg2n(sidtime * 15, kEraRate * (t - day));
+}
+
+double siderealFromOffset(double t, double offset) {
+  double day = std::floor(t + 0.5) - 0.5;
+  return ::swe_degnorm(offset + kEraRate * (t - day)) / 15;
+}
+
+} // namespace
+
+// swe_pheno_ut() for every body at every date, in date-major order
+// (index = date * bodies.size() + body). Delta T is computed once per date,
+// and the bodies of one date run back to back on one thread so that the
+// Sun, Earth and nutation saved by swe_calc() are reused between them.
+// swe_pheno() is called directly: swe_pheno_ut() compares its OK return
+// value with the ephemeris flag and so always computes everything twice.
+// A body and date that fail, e.g. an unknown body, are NaN and do not stop
+// the others.
+std::map<std::string, std::vector<double>> swe_pheno_batch(const std::vector<double> &tjd_ut, const std::vector<int> &bodies, int iflag) {
+  size_t nbody = bodies.size();
+  size_t cells = tjd_ut.size() * nbody;
+  std::map<std::string, std::vector<double>> result;
+  std::vector<double> *out[6];
+  for (int k = 0; k < 6; k++) {
+    out[k] = &result[kPhenoKeys[k]];
+    out[k]->assign(cells, NAN);
+  }
+  if (!(iflag & (SEFLG_JPLEPH | SEFLG_SWIEPH | SEFLG_MOSEPH))) {
+    iflag |= SEFLG_SWIEPH;
+  }
+  parallelFor(tjd_ut.size(), [&](size_t begin, size_t end, size_t) {
+    char serr[AS_MAXCH];
+    double attr[20];
+    for (size_t d = begin; d < end; d++) {
+      double deltat = ::swe_deltat_ex(tjd_ut[d], iflag, serr);
+      for (size_t b = 0; b < nbody; b++) {
+        if (::swe_pheno(tjd_ut[d] + deltat, bodies[b], iflag, attr, serr) < 0) {
+          continue;
+        }
+        for (int k = 0; k < 6; k++) {
+          (*out[k])[d * nbody + b] = attr[k];
+        }
+      }
+    }
+  });
+  return result;
+}
+
+// Nodes and apsides of `bodies` with each of `methods` for many dates, as
+// swe_nod_aps_ut() returns them, in arrays of 6 values per date, body and
+// method (date-major). Sun, earth and the osculating orbit of a body are
+// computed once per date, see swe_nod_aps_batch(). A body and method that
+// fail, e.g. an unknown body, are NaN and do not stop the others.
+std::map<std::string, std::vector<double>> swe_nod_aps_batch(const std::vector<double> &tjd_ut, const std::vector<int> &bodies, int iflag, const std::vector<int> &methods) {
+  static const char *const keys[] = {"ascending", "descending", "perihelion", "aphelion"};
+  size_t per = bodies.size() * methods.size();
+  std::map<std::string, std::vector<double>> result;
+  std::vector<double> *out[4];
+  for (int k = 0; k < 4; k++) {
+    out[k] = &result[keys[k]];
+    out[k]->assign(tjd_ut.size() * per * 6, NAN);
+  }
+  if (per == 0) {
+    return result;
+  }
+  std::vector<int32> ipl(bodies.begin(), bodies.end());
+  std::vector<int32> meth(methods.begin(), methods.end());
+  parallelFor(tjd_ut.size(), [&](size_t begin, size_t end, size_t) {
+    char serr[AS_MAXCH];
+    std::vector<double> xret(per * 24);
+    for (size_t d = begin; d < end; d++) {
+      bool failed = ::swe_nod_aps_batch_ut(tjd_ut[d], ipl.data(), (int32) ipl.size(), iflag, meth.data(), (int32) meth.size(), xret.data(), serr) < 0;
+      for (size_t c = 0; c < per; c++) {
+        // failed entries are all zero
+        if (failed && std::all_of(&xret[c * 24], &xret[c * 24 + 24], [](double x) { return x == 0; })) {
+          continue;
+        }
+        for (int k = 0; k < 4; k++) {
+          std::copy_n(&xret[c * 24 + k * 6], 6, &(*out[k])[(d * per + c) * 6]);
+        }
+      }
+    }
+  });
+  return result;
+}
+
+// Osculating lunar node, apogee and perigee for many dates, 6 values per
+// date each, see swe_lunar_osc_elem().
+std::map<std::string, std::vector<double>> swe_lunar_osc_batch(const std::vector<double> &tjd_ut, int iflag) {
+  std::map<std::string, std::vector<double>> result;
+  auto &node = result["node"], &apogee = result["apogee"], &perigee = result["perigee"];
+  node.assign(tjd_ut.size() * 6, NAN);
+  apogee.assign(tjd_ut.size() * 6, NAN);
+  perigee.assign(tjd_ut.size() * 6, NAN);
+  parallelFor(tjd_ut.size(), [&](size_t begin, size_t end, size_t) {
+    char serr[AS_MAXCH];
+    for (size_t d = begin; d < end; d++) {
+      if (::swe_lunar_osc_elem_ut(tjd_ut[d], iflag, &node[d * 6], &apogee[d * 6], &perigee[d * 6], serr) < 0) {
+        throw std::runtime_error(serr);
+      }
+    }
+  });
+  return result;
+}
+
+// swe_azalt() for many positions: `xin` holds (longitude, latitude) or
+// (right ascension, declination) pairs, date-major, the same number for
+// each of the dates `tjd_ut`. Sidereal time, obliquity and the rotation
+// are computed once per date, and the refraction comes from the table of
+// swi_refrac_extended().
+std::map<std::string, std::vector<double>> swe_azalt_batch(const std::vector<double> &tjd_ut, int calc_flag, const std::vector<double> &geopos,
+                                                           double atpress, double attemp, const std::vector<double> &xin) {
+  if (geopos.size() != 3) {
+    throw std::runtime_error("geopos must have 3 elements.");
+  }
+  size_t n = xin.size() / 2;
+  if (xin.size() % 2 != 0 || tjd_ut.empty() || n % tjd_ut.size() != 0) {
+    throw std::runtime_error("xin must hold 2 values for each position, the same number of positions for each date.");
+  }
+  size_t per = n / tjd_ut.size();
+  if (atpress == 0) {
+    /* estimate atmospheric pressure, as swe_azalt() does */
+    atpress = 1013.25 * std::pow(1 - 0.0065 * geopos[2] / 288, 5.255);
+  }
+  std::map<std::string, std::vector<double>> result;
+  auto &azimuth = result["azimuth"], &trueAlt = result["trueAltitude"], &appAlt = result["apparentAltitude"];
+  azimuth.resize(n);
+  trueAlt.resize(n);
+  appAlt.resize(n);
+  parallelFor(n, workerCount(n / kMinTransformChunk), [&](size_t begin, size_t end, size_t) {
+    UnitVectors v;
+    forEachDate(begin, end, per, [&](size_t t, size_t first, size_t count) {
+      double armc = ::swe_degnorm(::swe_sidtime(tjd_ut[t]) * 15 + geopos[0]);
+      double eps = calc_flag == SE_ECL2HOR ? trueObliquity(tjd_ut[t]) : 0;
+      HorizonRotation rot(armc, geopos[1], eps);
+      v.assign(&xin[2 * first], count);
+      v.rotate(rot.m, false);
+      for (size_t i = 0; i < count; i++) {
+        double az = std::atan2(v.y[i], v.x[i]) * RADTODEG;
+        double alt = std::atan2(v.z[i], std::hypot(v.x[i], v.y[i])) * RADTODEG;
+        azimuth[first + i] = ::swe_degnorm(az);
+        trueAlt[first + i] = alt;
+        appAlt[first + i] = ::swi_refrac_extended(alt, geopos[2], atpress, attemp, SE_LAPSE_RATE, SE_TRUE_TO_APP, NULL);
+      }
+    });
+  });
+  return result;
+}
+
+// swe_azalt_rev() for many (azimuth, true altitude) pairs, laid out as in
+// swe_azalt_batch().
+std::map<std::string, std::vector<double>> swe_azalt_rev_batch(const std::vector<double> &tjd_ut, int calc_flag, const std::vector<double> &geopos,
+                                                               const std::vector<double> &xin) {
+  if (geopos.size() != 3) {
+    throw std::runtime_error("geopos must have 3 elements.");
+  }
+  size_t n = xin.size() / 2;
+  if (xin.size() % 2 != 0 || tjd_ut.empty() || n % tjd_ut.size() != 0) {
+    throw std::runtime_error("xin must hold 2 values for each position, the same number of positions for each date.");
+  }
+  size_t per = n / tjd_ut.size();
+  std::map<std::string, std::vector<double>> result;
+  auto &longitude = result["longitude"], &latitude = result["latitude"];
+  longitude.resize(n);
+  latitude.resize(n);
+  parallelFor(n, workerCount(n / kMinTransformChunk), [&](size_t begin, size_t end, size_t) {
+    UnitVectors v;
+    forEachDate(begin, end, per, [&](size_t t, size_t first, size_t count) {
+      double armc = ::swe_degnorm(::swe_sidtime(tjd_ut[t]) * 15 + geopos[0]);
+      double eps = calc_flag == SE_HOR2ECL ? trueObliquity(tjd_ut[t]) : 0;
+      HorizonRotation rot(armc, geopos[1], eps);
+      v.assign(&xin[2 * first], count);
+      v.rotate(rot.m, true);
+      for (size_t i = 0; i < count; i++) {
+        longitude[first + i] = ::swe_degnorm(std::atan2(v.y[i], v.x[i]) * RADTODEG);
+        latitude[first + i] = std::atan2(v.z[i], std::hypot(v.x[i], v.y[i])) * RADTODEG;
+      }
+    });
+  });
+  return result;
+}
+
+// swe_sidtime() for many dates. Nutation, obliquity and the precession
+// terms change slowly; on days with many dates the difference between
+// sidereal time and the Earth rotation angle is interpolated from six
+// exact values, whatever model swe_sidtime0() uses. Results agree with
+// swe_sidtime() to 2e-6 seconds of time, the rounding noise of its own
+// Earth rotation angle far from J2000.
+std::vector<double> swe_sidtime_batch(const std::vector<double> &tjd_ut) {
+  return evaluateByDay(tjd_ut, [](double t) { return ::swe_sidtime(t); },
+                       [](double t) { return siderealOffset(t, ::swe_sidtime(t)); }, siderealFromOffset);
+}
+
+// swe_sidtime0() for many dates, with obliquity `eps` and nutation `nut`
+// for each date. The mean sidereal time is interpolated as in
+// swe_sidtime_batch(); the equation of the equinoxes is added for each date.
+std::vector<double> swe_sidtime0_batch(const std::vector<double> &tjd_ut, const std::vector<double> &eps, const std::vector<double> &nut) {
+  if (eps.size() != tjd_ut.size() || nut.size() != tjd_ut.size()) {
+    throw std::runtime_error("eps and nut must have one element for each date.");
+  }
+  for (double e : eps) {
+    if (e == 0) {
+      // swe_sidtime0() computes its own nutation when eps is 0
+      std::vector<double> result(tjd_ut.size());
+      for (size_t i = 0; i < tjd_ut.size(); i++) {
+        result[i] = ::swe_sidtime0(tjd_ut[i], eps[i], nut[i]);
+      }
+      return result;
+    }
+  }
+  // with nut = 0 and any eps != 0, swe_sidtime0() returns mean sidereal time
+  std::vector<double> mean = evaluateByDay(tjd_ut, [](double t) { return ::swe_sidtime0(t, 1, 0); },
+                                           [](double t) { return siderealOffset(t, ::swe_sidtime0(t, 1, 0)); },
+                                           siderealFromOffset);
+  for (size_t i = 0; i < mean.size(); i++) {
+    double st = mean[i] + nut[i] * std::cos(eps[i] * DEGTORAD) / 15;
+    mean[i] = st - 24 * std::floor(st / 24);
+  }
+  return mean;
+}
+
+// swe_time_equ() for many dates, in days. On days with many dates the
+// equation of time is interpolated from six exact values; the error is
+// below 1e-4 seconds.
+std::vector<double> swe_time_equ_batch(const std::vector<double> &tjd_ut) {
+  auto timeEqu = [](double t) {
+    double e;
+    char serr[AS_MAXCH] = "";
+    if (::swe_time_equ(t, &e, serr) < 0) {
+      throw std::runtime_error(serr);
+    }
+    return e;
+  };
+  return evaluateByDay(tjd_ut, timeEqu, timeEqu, [](double, double e) { return e; });
+}
+
+} // namespace swisseph
@@ -20,16 +20,20 @@ facebook::jsi::Object mapToJsiObject(facebook::jsi::Runtime &runtime, const std:
   return result;
 }
 
+facebook::jsi::Array vectorToJsiArray(facebook::jsi::Runtime &runtime, const std::vector<double> &value) {
+  facebook::jsi::Array jsiArray(runtime, value.size());
+  for (size_t i = 0; i < value.size(); ++i) {
+    jsiArray.setValueAtIndex(runtime, i, value[i]);
+  }
+  return jsiArray;
+}
+
 facebook::jsi::Object mapVectorToJsiObject(facebook::jsi::Runtime &runtime,
                                            const std::map<std::string, std::vector<double>> &map) {
   facebook::jsi::Object result(runtime);
   for (const auto &[key, value] : map) {
-    facebook::jsi::Array jsiArray(runtime, value.size());
-    for (size_t i = 0; i < value.size(); ++i) {
-      jsiArray.setValueAtIndex(runtime, i, value[i]);
-    }
     // 将 JSI 数组设置为对象的属性
-    result.setProperty(runtime, key.c_str(), std::move(jsiArray));
+    result.setProperty(runtime, key.c_str(), vectorToJsiArray(runtime, value));
   }
   return result;
 }
@@ -55,6 +59,34 @@ std::vector<double> jsiArrayToVector(facebook::jsi::Runtime &rt, const facebook:
   return result;
 }
 
+std::vector<int> jsiArrayToIntVector(facebook::jsi::Runtime &rt, const facebook::jsi::Value &value) {
+  std::vector<double> numbers = jsiArrayToVector(rt, value);
+  return std::vector<int>(numbers.begin(), numbers.end());
+}
+
+std::vector<std::string> jsiArrayToStringVector(facebook::jsi::Runtime &rt, const facebook::jsi::Value &value) {
+  std::vector<std::string> result;
+  if (value.isObject() && value.asObject(rt).isArray(rt)) {
+    auto array = value.asObject(rt).asArray(rt);
+    size_t size = array.size(rt);
+    result.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        result.push_back(array.getValueAtIndex(rt, i).getString(rt).utf8(rt));
+    }
+  } else {
+    throw facebook::jsi::JSError(rt, "Expected an array of strings");
+  }
+  return result;
+}
+
+// The JS thread has its own swed; make sure it knows the ephemeris path
+// before a native job captures it for the worker threads.
+void ensureEphemerisPath() {
+  if (swisseph::getPath().empty() && !getGlobalEphemerisPath().empty()) {
+    swisseph::swe_set_ephe_path(getGlobalEphemerisPath().c_str());
+  }
+}
+
 
 static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweJulday(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
   try {
@@ -395,39 +427,8 @@ static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweHeliacalPhen
     auto result = swisseph::swe_heliacal_pheno_ut(tjd_ut, dgeo, datm, dobs, object_name, event_type, helflag);
 
     facebook::jsi::Object obj = facebook::jsi::Object(rt);
-    std::vector<std::string> keys = {"tcAltitude",
-                                 "tcApparentAltitude",
-                                 "gcAltitude",
-                                 "azimuth",
-                                 "tcSunAltitude",
-                                 "sunAzimuth",
-                                 "tcActualVisibleArc",
-                                 "gcActualVisibleArc",
-                                 "objectToSunAzimuth",
-                                 "objectToSunLongitude",
-                                 "extinction",
-                                 "tcMinVisibleArc",
-                                 "firstVisible",
-                                 "bestVisible",
-                                 "endVisible",
-                                 "yallopBestVisible",
-                                 "moonCresentWidth",
-                                 "yallopValue",
-                                 "yallopCriterion",
-                                 "parallax",
-                                 "magnitude",
-                                 "rise",
-                                 "riseSet",
-                                 "riseObjectToSun",
-                                 "visibleDuration",
-                                 "moonCresetLength",
-                                 "elong",
-                                 "illumination",
-                                 "kOZ",
-                                 "ka",
-                                 "ksumm"};
     for (size_t i = 1; i < result.size(); ++i) {
-      auto propName = facebook::jsi::PropNameID::forUtf8(rt, keys[i - 1]);
+      auto propName = facebook::jsi::PropNameID::forUtf8(rt, swisseph::kHeliacalPhenoKeys[i - 1]);
       obj.setProperty(rt, propName, result[i]);
     }
     return facebook::jsi::Value(std::move(obj));
@@ -452,7 +453,7 @@ static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweHeliacalUt(f
     facebook::jsi::Object obj = facebook::jsi::Object(rt);
     std::vector<std::string> keys = {"startVisible", "bestVisible", "endVisible"};
     for (size_t i = 1; i < result.size(); ++i) {
-        auto propName = facebook::jsi::PropNameID::forUtf8(rt, keys[i - 1]);
+        auto propName = facebook::jsi::PropNameID::forUtf8(rt, swisseph::kHeliacalPhenoKeys[i - 1]);
         obj.setProperty(rt, propName, result[i]);
     }
     return facebook::jsi::Value(std::move(obj));
@@ -474,7 +475,7 @@ static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweVisLimitMag(
     facebook::jsi::Object obj = facebook::jsi::Object(rt);
     std::vector<std::string> keys = {"vissualMagnitudeLimit", "AltO", "AziO", "AltS", "AziS", "AltM", "AziM"};
     for (size_t i = 1; i < result.size(); ++i) {
-      auto propName = facebook::jsi::PropNameID::forUtf8(rt, keys[i - 1]);
+      auto propName = facebook::jsi::PropNameID::forUtf8(rt, swisseph::kHeliacalPhenoKeys[i - 1]);
       obj.setProperty(rt, propName, result[i]);
     }
     return facebook::jsi::Value(std::move(obj));
@@ -484,6 +485,413 @@ static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweVisLimitMag(
   return facebook::jsi::Value::undefined();
 }
 
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweTransitScan(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> natal = jsiArrayToVector(rt, args[0]);
+    std::vector<int> bodies = jsiArrayToIntVector(rt, args[1]);
+    std::vector<double> aspects = jsiArrayToVector(rt, args[2]);
+    std::vector<double> orbs = jsiArrayToVector(rt, args[3]);
+    double tjd_start = args[4].getNumber();
+    double tjd_end = args[5].getNumber();
+    int iflag = args[6].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_transit_scan(natal, bodies, aspects, orbs, tjd_start, tjd_end, iflag);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweLunations(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    double tjd_start = args[0].getNumber();
+    double tjd_end = args[1].getNumber();
+    std::vector<double> phases = jsiArrayToVector(rt, args[2]);
+    int iflag = args[3].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_lunations(tjd_start, tjd_end, phases, iflag);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweRiseTransCalendar(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    double tjd_start = args[0].getNumber();
+    int ndays = args[1].getNumber();
+    std::vector<double> geopos = jsiArrayToVector(rt, args[2]);
+    std::vector<int> bodies = jsiArrayToIntVector(rt, args[3]);
+    int epheflag = args[4].getNumber();
+    int rsmi = args[5].getNumber();
+    double atpress = args[6].getNumber();
+    double attemp = args[7].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_rise_trans_calendar(tjd_start, ndays, geopos, bodies, epheflag, rsmi, atpress, attemp);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweHorizonEvents(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    double tjd_start = args[0].getNumber();
+    double tjd_end = args[1].getNumber();
+    std::vector<double> geopos = jsiArrayToVector(rt, args[2]);
+    std::vector<int> bodies = jsiArrayToIntVector(rt, args[3]);
+    std::vector<std::string> stars = jsiArrayToStringVector(rt, args[4]);
+    int epheflag = args[5].getNumber();
+    int rsmi = args[6].getNumber();
+    double atpress = args[7].getNumber();
+    double attemp = args[8].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_horizon_events(tjd_start, tjd_end, geopos, bodies, stars, epheflag, rsmi, atpress, attemp);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweTwilightTable(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    double tjd_start = args[0].getNumber();
+    int ndays = args[1].getNumber();
+    std::vector<double> geopos = jsiArrayToVector(rt, args[2]);
+    int epheflag = args[3].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_twilight_table(tjd_start, ndays, geopos, epheflag);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweVisLimitMagGrid(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    double tjd_ut = args[0].getNumber();
+    std::vector<double> dgeo = jsiArrayToVector(rt, args[1]);
+    std::vector<double> datm = jsiArrayToVector(rt, args[2]);
+    std::vector<double> dobs = jsiArrayToVector(rt, args[3]);
+    int helflag = args[4].getNumber();
+    std::vector<double> azimuths = jsiArrayToVector(rt, args[5]);
+    std::vector<double> altitudes = jsiArrayToVector(rt, args[6]);
+    ensureEphemerisPath();
+    auto result = swisseph::swe_vis_limit_mag_grid(tjd_ut, dgeo, datm, dobs, helflag, azimuths, altitudes);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweHeliacalCalendar(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    double tjd_start = args[0].getNumber();
+    double tjd_end = args[1].getNumber();
+    std::vector<double> dgeo = jsiArrayToVector(rt, args[2]);
+    std::vector<double> datm = jsiArrayToVector(rt, args[3]);
+    std::vector<double> dobs = jsiArrayToVector(rt, args[4]);
+    double maglimit = args[5].getNumber();
+    std::vector<int> events = jsiArrayToIntVector(rt, args[6]);
+    int helflag = args[7].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_heliacal_calendar(tjd_start, tjd_end, dgeo, datm, dobs, maglimit, events, helflag);
+    facebook::jsi::Object obj = mapVectorToJsiObject(rt, result.events);
+    facebook::jsi::Array stars(rt, result.stars.size());
+    facebook::jsi::Array magnitudes(rt, result.magnitudes.size());
+    for (size_t i = 0; i < result.stars.size(); i++) {
+      stars.setValueAtIndex(rt, i, facebook::jsi::String::createFromUtf8(rt, result.stars[i]));
+      magnitudes.setValueAtIndex(rt, i, result.magnitudes[i]);
+    }
+    obj.setProperty(rt, "stars", std::move(stars));
+    obj.setProperty(rt, "magnitudes", std::move(magnitudes));
+    return facebook::jsi::Value(std::move(obj));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweHeliacalPhenoBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    std::vector<double> geopos = jsiArrayToVector(rt, args[1]);
+    std::vector<double> datm = jsiArrayToVector(rt, args[2]);
+    std::vector<double> dobs = jsiArrayToVector(rt, args[3]);
+    std::string object_name = args[4].getString(rt).utf8(rt);
+    int event_type = args[5].getNumber();
+    int helflag = args[6].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_heliacal_pheno_batch(tjd_ut, geopos, datm, dobs, object_name, event_type, helflag);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweEclipseCatalogWhen(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::string file = args[0].getString(rt).utf8(rt);
+    double tjd_start = args[1].getNumber();
+    int body = args[2].getNumber();
+    int ifltype = args[3].getNumber();
+    bool backward = args[4].getBool();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_eclipse_catalog_when(file, tjd_start, body, ifltype, backward);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweEclipseCatalogRange(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::string file = args[0].getString(rt).utf8(rt);
+    double tjd_start = args[1].getNumber();
+    double tjd_end = args[2].getNumber();
+    int body = args[3].getNumber();
+    int ifltype = args[4].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_eclipse_catalog_range(file, tjd_start, tjd_end, body, ifltype);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweSolEclipseMap(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    double tjd_ut = args[0].getNumber();
+    int iflag = args[1].getNumber();
+    double lon_step = args[2].getNumber();
+    double lat_step = args[3].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_sol_eclipse_map(tjd_ut, iflag, lon_step, lat_step);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweLunOccultScan(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    double tjd_start = args[0].getNumber();
+    double tjd_end = args[1].getNumber();
+    std::vector<int> bodies = jsiArrayToIntVector(rt, args[2]);
+    std::vector<std::string> stars = jsiArrayToStringVector(rt, args[3]);
+    double maglimit = args[4].getNumber();
+    int iflag = args[5].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_lun_occult_scan(tjd_start, tjd_end, bodies, stars, maglimit, iflag);
+    facebook::jsi::Object obj = mapVectorToJsiObject(rt, result.events);
+    facebook::jsi::Array targets(rt, result.targets.size());
+    for (size_t i = 0; i < result.targets.size(); i++) {
+      targets.setValueAtIndex(rt, i, facebook::jsi::String::createFromUtf8(rt, result.targets[i]));
+    }
+    obj.setProperty(rt, "targets", std::move(targets));
+    return facebook::jsi::Value(std::move(obj));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweEclipseWhenLocBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    double tjd_ut = args[0].getNumber();
+    int body = args[1].getNumber();
+    std::vector<double> geopos = jsiArrayToVector(rt, args[2]);
+    int iflag = args[3].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_eclipse_when_loc_batch(tjd_ut, body, geopos, iflag);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_swePhenoBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    std::vector<int> bodies = jsiArrayToIntVector(rt, args[1]);
+    int iflag = args[2].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_pheno_batch(tjd_ut, bodies, iflag);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweAzaltBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    int calc_flag = args[1].getNumber();
+    std::vector<double> geopos = jsiArrayToVector(rt, args[2]);
+    double atpress = args[3].getNumber();
+    double attemp = args[4].getNumber();
+    std::vector<double> xin = jsiArrayToVector(rt, args[5]);
+    ensureEphemerisPath();
+    auto result = swisseph::swe_azalt_batch(tjd_ut, calc_flag, geopos, atpress, attemp, xin);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweAzaltRevBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    int calc_flag = args[1].getNumber();
+    std::vector<double> geopos = jsiArrayToVector(rt, args[2]);
+    std::vector<double> xin = jsiArrayToVector(rt, args[3]);
+    ensureEphemerisPath();
+    auto result = swisseph::swe_azalt_rev_batch(tjd_ut, calc_flag, geopos, xin);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweSidtimeBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    ensureEphemerisPath();
+    auto result = swisseph::swe_sidtime_batch(tjd_ut);
+    return facebook::jsi::Value(vectorToJsiArray(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweSidtime0Batch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    std::vector<double> eps = jsiArrayToVector(rt, args[1]);
+    std::vector<double> nut = jsiArrayToVector(rt, args[2]);
+    ensureEphemerisPath();
+    auto result = swisseph::swe_sidtime0_batch(tjd_ut, eps, nut);
+    return facebook::jsi::Value(vectorToJsiArray(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweTimeEquBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    ensureEphemerisPath();
+    auto result = swisseph::swe_time_equ_batch(tjd_ut);
+    return facebook::jsi::Value(vectorToJsiArray(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweSetMemoryLimit(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    int nbytes = args[0].getNumber();
+    swisseph::swe_set_memory_limit(nbytes);
+    return facebook::jsi::Value::undefined();
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweGetMemoryStats(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    auto result = swisseph::swe_get_memory_stats();
+    return facebook::jsi::Value(mapToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweNodApsBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    std::vector<int> bodies = jsiArrayToIntVector(rt, args[1]);
+    int iflag = args[2].getNumber();
+    std::vector<int> methods = jsiArrayToIntVector(rt, args[3]);
+    ensureEphemerisPath();
+    auto result = swisseph::swe_nod_aps_batch(tjd_ut, bodies, iflag, methods);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweLunarOscBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    int iflag = args[1].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_lunar_osc_batch(tjd_ut, iflag);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweGauquelinSectorBatch(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    std::vector<double> tjd_ut = jsiArrayToVector(rt, args[0]);
+    std::vector<double> geopos = jsiArrayToVector(rt, args[1]);
+    std::vector<int> bodies = jsiArrayToIntVector(rt, args[2]);
+    int iflag = args[3].getNumber();
+    int imeth = args[4].getNumber();
+    double atpress = args[5].getNumber();
+    double attemp = args[6].getNumber();
+    ensureEphemerisPath();
+    auto result = swisseph::swe_gauquelin_sector_batch(tjd_ut, geopos, bodies, iflag, imeth, atpress, attemp);
+    return facebook::jsi::Value(mapVectorToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweGetStats(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    auto result = swisseph::swe_get_stats();
+    return facebook::jsi::Value(mapToJsiObject(rt, result));
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+static facebook::jsi::Value __hostFunction_NativeSwissephSpecJSI_sweResetStats(facebook::jsi::Runtime& rt, TurboModule &turboModule, const facebook::jsi::Value* args, size_t count) {
+  try {
+    swisseph::swe_reset_stats();
+    return facebook::jsi::Value::undefined();
+  } catch (std::exception &e) {
+      printStackTrace(rt, e);
+  }
+  return facebook::jsi::Value::undefined();
+}
+
 
 std::unordered_map<std::string, SwissephMethodMetadata> createMethodMap(){
   return {
@@ -511,7 +919,33 @@ std::unordered_map<std::string, SwissephMethodMetadata> createMethodMap(){
     {"sweHeliacalPhenoUt", SwissephMethodMetadata {7, __hostFunction_NativeSwissephSpecJSI_sweHeliacalPhenoUt}},
     {"sweHeliacalUt", SwissephMethodMetadata {7, __hostFunction_NativeSwissephSpecJSI_sweHeliacalUt}},
     {"sweVisLimitMag", SwissephMethodMetadata {6, __hostFunction_NativeSwissephSpecJSI_sweVisLimitMag}},
-    {"sweNodApsUt", SwissephMethodMetadata {4, __hostFunction_NativeSwissephSpecJSI_sweNodApsUt}}
+    {"sweNodApsUt", SwissephMethodMetadata {4, __hostFunction_NativeSwissephSpecJSI_sweNodApsUt}},
+    {"sweTransitScan", SwissephMethodMetadata {7, __hostFunction_NativeSwissephSpecJSI_sweTransitScan}},
+    {"sweLunations", SwissephMethodMetadata {4, __hostFunction_NativeSwissephSpecJSI_sweLunations}},
+    {"sweRiseTransCalendar", SwissephMethodMetadata {8, __hostFunction_NativeSwissephSpecJSI_sweRiseTransCalendar}},
+    {"sweHorizonEvents", SwissephMethodMetadata {9, __hostFunction_NativeSwissephSpecJSI_sweHorizonEvents}},
+    {"sweTwilightTable", SwissephMethodMetadata {4, __hostFunction_NativeSwissephSpecJSI_sweTwilightTable}},
+    {"sweVisLimitMagGrid", SwissephMethodMetadata {7, __hostFunction_NativeSwissephSpecJSI_sweVisLimitMagGrid}},
+    {"sweHeliacalCalendar", SwissephMethodMetadata {8, __hostFunction_NativeSwissephSpecJSI_sweHeliacalCalendar}},
+    {"sweHeliacalPhenoBatch", SwissephMethodMetadata {7, __hostFunction_NativeSwissephSpecJSI_sweHeliacalPhenoBatch}},
+    {"sweEclipseCatalogWhen", SwissephMethodMetadata {5, __hostFunction_NativeSwissephSpecJSI_sweEclipseCatalogWhen}},
+    {"sweEclipseCatalogRange", SwissephMethodMetadata {5, __hostFunction_NativeSwissephSpecJSI_sweEclipseCatalogRange}},
+    {"sweSolEclipseMap", SwissephMethodMetadata {4, __hostFunction_NativeSwissephSpecJSI_sweSolEclipseMap}},
+    {"sweLunOccultScan", SwissephMethodMetadata {6, __hostFunction_NativeSwissephSpecJSI_sweLunOccultScan}},
+    {"sweEclipseWhenLocBatch", SwissephMethodMetadata {4, __hostFunction_NativeSwissephSpecJSI_sweEclipseWhenLocBatch}},
+    {"swePhenoBatch", SwissephMethodMetadata {3, __hostFunction_NativeSwissephSpecJSI_swePhenoBatch}},
+    {"sweAzaltBatch", SwissephMethodMetadata {6, __hostFunction_NativeSwissephSpecJSI_sweAzaltBatch}},
+    {"sweAzaltRevBatch", SwissephMethodMetadata {4, __hostFunction_NativeSwissephSpecJSI_sweAzaltRevBatch}},
+    {"sweSidtimeBatch", SwissephMethodMetadata {1, __hostFunction_NativeSwissephSpecJSI_sweSidtimeBatch}},
+    {"sweSidtime0Batch", SwissephMethodMetadata {3, __hostFunction_NativeSwissephSpecJSI_sweSidtime0Batch}},
+    {"sweTimeEquBatch", SwissephMethodMetadata {1, __hostFunction_NativeSwissephSpecJSI_sweTimeEquBatch}},
+    {"sweSetMemoryLimit", SwissephMethodMetadata {1, __hostFunction_NativeSwissephSpecJSI_sweSetMemoryLimit}},
+    {"sweGetMemoryStats", SwissephMethodMetadata {0, __hostFunction_NativeSwissephSpecJSI_sweGetMemoryStats}},
+    {"sweNodApsBatch", SwissephMethodMetadata {4, __hostFunction_NativeSwissephSpecJSI_sweNodApsBatch}},
+    {"sweLunarOscBatch", SwissephMethodMetadata {2, __hostFunction_NativeSwissephSpecJSI_sweLunarOscBatch}},
+    {"sweGauquelinSectorBatch", SwissephMethodMetadata {7, __hostFunction_NativeSwissephSpecJSI_sweGauquelinSectorBatch}},
+    {"sweGetStats", SwissephMethodMetadata {0, __hostFunction_NativeSwissephSpecJSI_sweGetStats}},
+    {"sweResetStats", SwissephMethodMetadata {0, __hostFunction_NativeSwissephSpecJSI_sweResetStats}}
   };
 }
 }
@@ -0,0 +1,194 @@
+#ifndef SWISSEPH_BATCH_H
+#define SWISSEPH_BATCH_H
+#include "RNSwisseph.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+namespace swisseph {
+
+// swed is only thread local where sweodef.h defines TLS; on Apple it is a
+// plain global and every batch job has to stay on the calling thread.
+#if !defined(__APPLE__)
+constexpr bool kThreadLocalSwed = true;
+#else
+constexpr bool kThreadLocalSwed = false;
+#endif
+
+// Settings of the calling thread's swed that a worker thread has to replay
+// on its own (thread local) copy before it can compute anything.
+struct ThreadContext {
+  std::string ephePath;
+  std::string jplFile;
+  bool sidModeSet = false;
+  int32 sidMode = 0;
+  double sidT0 = 0;
+  double sidAyanT0 = 0;
+  bool topoSet = false;
+  double geolon = 0, geolat = 0, geoalt = 0;
+  int32 memoryLimit = 0;
+
+  static ThreadContext capture() {
+    ThreadContext ctx;
+    ctx.ephePath = swed.ephepath;
+    ctx.jplFile = swed.jplfnam;
+    ctx.sidModeSet = swed.ayana_is_set;
+    ctx.sidMode = swed.sidd.sid_mode;
+    ctx.sidT0 = swed.sidd.t0;
+    ctx.sidAyanT0 = swed.sidd.ayan_t0;
+    ctx.topoSet = swed.geopos_is_set;
+    ctx.geolon = swed.topd.geolon;
+    ctx.geolat = swed.topd.geolat;
+    ctx.geoalt = swed.topd.geoalt;
+    int32 stats[6];
+    ctx.memoryLimit = ::swe_get_memory_stats(stats);
+    return ctx;
+  }
+
+  void apply() const {
+    if (memoryLimit > 0) {
+      ::swe_set_memory_limit(memoryLimit);
+    }
+    ::swe_set_ephe_path(ephePath.empty() ? NULL : const_cast<char*>(ephePath.c_str()));
+    if (!jplFile.empty()) {
+      ::swe_set_jpl_file(const_cast<char*>(jplFile.c_str()));
+    }
+    if (sidModeSet) {
+      ::swe_set_sid_mode(sidMode, sidT0, sidAyanT0);
+    }
+    if (topoSet) {
+      ::swe_set_topo(geolon, geolat, geoalt);
+    }
+  }
+};
+
+// Adds the counters and timers of a worker's swed (see swe_get_stats) to
+// the calling thread's, so that batch calls show up in its statistics.
+inline void mergeStats(const stats_data &from) {
+#ifdef SWE_STATS
+  for (int i = 0; i < SE_NSTAT_COUNTERS; i++) {
+    swed.stats.count[i] += from.count[i];
+  }
+  for (int i = 0; i < SE_NSTAT_TIMERS; i++) {
+    swed.stats.calls[i] += from.calls[i];
+    swed.stats.seconds[i] += from.seconds[i];
+  }
+#else
+  (void) from;
+#endif
+}
+
+// Number of workers for `jobs` independent units of work.
+inline size_t workerCount(size_t jobs) {
+  if (!kThreadLocalSwed || jobs < 2) {
+    return 1;
+  }
+  size_t hw = std::max(1u, std::thread::hardware_concurrency());
+  return std::min(hw, jobs);
+}
+
+// Splits [0, n) into contiguous ranges and calls fn(begin, end, worker) for
+// each of them. Worker 0 runs on the calling thread with its swed untouched;
+// the others replay the caller's ThreadContext and close their files when
+// done, and their statistics are merged into the caller's. The first
+// exception thrown by any worker is rethrown here.
+template <typename Fn>
+void parallelFor(size_t n, size_t workers, Fn fn) {
+  if (n == 0) {
+    return;
+  }
+  workers = std::max<size_t>(1, std::min(workers, n));
+  if (workers == 1) {
+    fn(0, n, 0);
+    return;
+  }
+  ThreadContext ctx = ThreadContext::capture();
+  std::vector<std::exception_ptr> errors(workers);
+  std::vector<stats_data> stats(workers);
+  std::vector<std::thread> threads;
+  size_t chunk = (n + workers - 1) / workers;
+  for (size_t w = 1; w < workers; w++) {
+    size_t begin = w * chunk;
+    size_t end = std::min(n, begin + chunk);
+    if (begin >= end) {
+      break;
+    }
+    threads.emplace_back([&, begin, end, w]() {
+      try {
+        ctx.apply();
+        fn(begin, end, w);
+      } catch (...) {
+        errors[w] = std::current_exception();
+      }
+      ::swe_close();
+      stats[w] = swed.stats;
+    });
+  }
+  try {
+    fn(0, std::min(n, chunk), 0);
+  } catch (...) {
+    errors[0] = std::current_exception();
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (size_t w = 1; w < workers; w++) {
+    mergeStats(stats[w]);
+  }
+  for (auto &e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+template <typename Fn>
+void parallelFor(size_t n, Fn fn) {
+  parallelFor(n, workerCount(n), fn);
+}
+
+// Normalizes an angle difference to [-180, 180).
+inline double diffDeg(double a, double b) {
+  return ::swe_difdeg2n(a, b);
+}
+
+// Root of f in the bracket [ta, tb] (fa and fb of opposite sign) by the
+// Illinois variant of regula falsi. Stops when the bracket is shorter than
+// `tol` days.
+template <typename Fn>
+double findRoot(Fn f, double ta, double fa, double tb, double fb, double tol = 1e-7) {
+  int side = 0;
+  double t = tb;
+  for (int i = 0; i < 100 && std::fabs(tb - ta) > tol; i++) {
+    t = (fa * tb - fb * ta) / (fa - fb);
+    if (!(t > ta && t < tb)) {
+      t = 0.5 * (ta + tb);
+    }
+    double ft = f(t);
+    if (ft == 0) {
+      return t;
+    }
+    if ((ft < 0) == (fb < 0)) {
+      tb = t;
+      fb = ft;
+      if (side == -1) {
+        fa /= 2;
+      }
+      side = -1;
+    } else {
+      ta = t;
+      fa = ft;
+      if (side == 1) {
+        fb /= 2;
+      }
+      side = 1;
+    }
+  }
+  return t;
+}
+
+} // namespace swisseph
+
+#endif /* SWISSEPH_BATCH_H */
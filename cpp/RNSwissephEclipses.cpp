@@ -0,0 +1,1029 @@
+#include "RNSwissephEclipses.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace swisseph {
+
+namespace {
+
+constexpr int32 kEpheMask = SEFLG_JPLEPH | SEFLG_SWIEPH | SEFLG_MOSEPH;
+constexpr double kMoonDiameter = 3476300.0; /* m, as DMOON in swecl.c */
+
+// Binary eclipse catalog written by swe_eclipse_catalog_build(): a header
+// followed by fixed size records sorted by the time of maximum. Integers and
+// doubles are stored in the native (little endian on every supported target)
+// layout.
+constexpr char kCatalogMagic[8] = {'S', 'E', 'E', 'C', 'L', 'C', 'A', 'T'};
+constexpr int32 kCatalogVersion = 1;
+
+struct CatalogHeader {
+  char magic[8];
+  int32 version;
+  int32 recordSize;
+  int32 count;
+  int32 iflag;
+  double tjdStart;
+  double tjdEnd;
+};
+
+struct CatalogRecord {
+  double tret[10];   /* as returned by swe_sol_eclipse_when_glob() / swe_lun_eclipse_when() */
+  double magnitude;  /* solar: NASA magnitude at greatest eclipse; lunar: umbral */
+  double gamma;      /* distance of the shadow axis from the Earth's center, Earth radii */
+  int32 type;        /* SE_ECL_* flags */
+  int32 body;        /* SE_SUN for solar, SE_MOON for lunar eclipses */
+  int32 sarosSeries;
+  int32 sarosMember;
+};
+
+static_assert(sizeof(CatalogHeader) == 40, "unexpected catalog header layout");
+static_assert(sizeof(CatalogRecord) == 112, "unexpected catalog record layout");
+
+struct Catalog {
+  CatalogHeader header;
+  std::vector<CatalogRecord> records;
+};
+
+// Signed distance in Earth radii between the Earth's center and the line
+// through `x` with direction `u`; positive if the closest point of the line
+// lies north of the equator.
+double axisDistance(const double *x, const double *u) {
+  double ulen = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+  double d = (x[0] * u[0] + x[1] * u[1] + x[2] * u[2]) / (ulen * ulen);
+  double p[3];
+  for (int i = 0; i < 3; i++) {
+    p[i] = x[i] - d * u[i];
+  }
+  double r = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]) * AUNIT / EARTH_RADIUS;
+  return p[2] < 0 ? -r : r;
+}
+
+// Gamma of the eclipse at maximum from geocentric equatorial positions: the
+// axis of the lunar shadow for solar eclipses, the Moon's center relative to
+// the axis of the Earth's shadow for lunar eclipses.
+double eclipseGamma(double tjd_ut, int body, int iflag) {
+  double xs[6], xm[6];
+  char serr[AS_MAXCH];
+  int32 flags = (iflag & kEpheMask) | SEFLG_EQUATORIAL | SEFLG_XYZ;
+  if (::swe_calc_ut(tjd_ut, SE_SUN, flags, xs, serr) < 0 || ::swe_calc_ut(tjd_ut, SE_MOON, flags, xm, serr) < 0) {
+    throw std::runtime_error(serr);
+  }
+  double u[3];
+  if (body == SE_SUN) {
+    for (int i = 0; i < 3; i++) {
+      u[i] = xm[i] - xs[i];
+    }
+  } else {
+    for (int i = 0; i < 3; i++) {
+      u[i] = -xs[i];
+    }
+  }
+  return axisDistance(xm, u);
+}
+
+CatalogRecord solarRecord(const double *tret, int32 retflag, int iflag) {
+  CatalogRecord r = {};
+  double geopos[10], attr[20];
+  char serr[AS_MAXCH];
+  std::copy(tret, tret + 10, r.tret);
+  if (::swe_sol_eclipse_where(tret[0], iflag, geopos, attr, serr) < 0) {
+    throw std::runtime_error(serr);
+  }
+  r.type = retflag & SE_ECL_ALLTYPES_SOLAR;
+  r.body = SE_SUN;
+  r.magnitude = attr[8];
+  r.gamma = eclipseGamma(tret[0], SE_SUN, iflag);
+  r.sarosSeries = static_cast<int32>(attr[9]);
+  r.sarosMember = static_cast<int32>(attr[10]);
+  return r;
+}
+
+CatalogRecord lunarRecord(const double *tret, int32 retflag, int iflag) {
+  CatalogRecord r = {};
+  double attr[20];
+  char serr[AS_MAXCH];
+  std::copy(tret, tret + 10, r.tret);
+  if (::swe_lun_eclipse_how(tret[0], iflag, NULL, attr, serr) < 0) {
+    throw std::runtime_error(serr);
+  }
+  r.type = retflag & SE_ECL_ALLTYPES_LUNAR;
+  r.body = SE_MOON;
+  r.magnitude = attr[0];
+  r.gamma = eclipseGamma(tret[0], SE_MOON, iflag);
+  r.sarosSeries = static_cast<int32>(attr[9]);
+  r.sarosMember = static_cast<int32>(attr[10]);
+  return r;
+}
+
+// All eclipses of one kind with maximum in [ts, te).
+void searchSlice(double ts, double te, int body, int iflag, std::vector<CatalogRecord> &out) {
+  double tret[10];
+  char serr[AS_MAXCH];
+  for (double t = ts;;) {
+    std::fill(tret, tret + 10, 0.0);
+    int32 retflag = body == SE_SUN ? ::swe_sol_eclipse_when_glob(t, iflag, 0, tret, 0, serr)
+                                   : ::swe_lun_eclipse_when(t, iflag, 0, tret, 0, serr);
+    if (retflag < 0) {
+      throw std::runtime_error(serr);
+    }
+    if (tret[0] >= te) {
+      break;
+    }
+    if (tret[0] >= ts) {
+      out.push_back(body == SE_SUN ? solarRecord(tret, retflag, iflag) : lunarRecord(tret, retflag, iflag));
+    }
+    t = tret[0] + 1;
+  }
+}
+
+// Reads a catalog by name, searching the ephemeris path like the ephemeris
+// files themselves. Loaded catalogs are immutable and shared by all threads.
+std::shared_ptr<const Catalog> loadCatalog(const std::string &file) {
+  static std::mutex mutex;
+  static std::map<std::string, std::shared_ptr<const Catalog>> loaded;
+  std::string key = file + '\n' + swed.ephepath;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = loaded.find(key);
+  if (it != loaded.end()) {
+    return it->second;
+  }
+  char serr[AS_MAXCH] = "";
+  FILE *fp = ::swi_fopen(-1, const_cast<char *>(file.c_str()), swed.ephepath, serr);
+  if (fp == NULL) {
+    throw std::runtime_error(*serr ? serr : "eclipse catalog " + file + " not found");
+  }
+  auto catalog = std::make_shared<Catalog>();
+  bool ok = fread(&catalog->header, sizeof(CatalogHeader), 1, fp) == 1
+    && memcmp(catalog->header.magic, kCatalogMagic, sizeof(kCatalogMagic)) == 0
+    && catalog->header.version == kCatalogVersion
+    && catalog->header.recordSize == static_cast<int32>(sizeof(CatalogRecord))
+    && catalog->header.count >= 0;
+  if (ok) {
+    catalog->records.resize(catalog->header.count);
+    ok = fread(catalog->records.data(), sizeof(CatalogRecord), catalog->records.size(), fp) == catalog->records.size();
+  }
+  fclose(fp);
+  if (!ok) {
+    throw std::runtime_error(file + " is not a valid eclipse catalog.");
+  }
+  loaded[key] = catalog;
+  return catalog;
+}
+
+// Expands ifltype the way swe_sol_eclipse_when_glob() and
+// swe_lun_eclipse_when() do, so that catalog queries select the same
+// eclipses as the searches.
+int32 normalizeType(int body, int32 ifltype) {
+  if (body == SE_SUN) {
+    if (ifltype == (SE_ECL_PARTIAL | SE_ECL_CENTRAL)) {
+      throw std::runtime_error("central partial eclipses do not exist");
+    }
+    if (ifltype == (SE_ECL_ANNULAR_TOTAL | SE_ECL_NONCENTRAL)) {
+      throw std::runtime_error("non-central hybrid (annular-total) eclipses do not exist");
+    }
+    if (ifltype == 0) {
+      ifltype = SE_ECL_ALLTYPES_SOLAR;
+    }
+    if (ifltype == SE_ECL_TOTAL || ifltype == SE_ECL_ANNULAR || ifltype == SE_ECL_ANNULAR_TOTAL) {
+      ifltype |= SE_ECL_NONCENTRAL | SE_ECL_CENTRAL;
+    }
+    if (ifltype == SE_ECL_PARTIAL) {
+      ifltype |= SE_ECL_NONCENTRAL;
+    }
+    return ifltype & SE_ECL_ALLTYPES_SOLAR;
+  }
+  if (body != SE_MOON) {
+    throw std::runtime_error("body must be SE_SUN or SE_MOON.");
+  }
+  ifltype &= ~(SE_ECL_CENTRAL | SE_ECL_NONCENTRAL);
+  if (ifltype & (SE_ECL_ANNULAR | SE_ECL_ANNULAR_TOTAL)) {
+    ifltype &= ~(SE_ECL_ANNULAR | SE_ECL_ANNULAR_TOTAL);
+    if (ifltype == 0) {
+      throw std::runtime_error("annular lunar eclipses don't exist");
+    }
+  }
+  if (ifltype == 0) {
+    ifltype = SE_ECL_ALLTYPES_LUNAR;
+  }
+  return ifltype & SE_ECL_ALLTYPES_LUNAR;
+}
+
+bool matches(const CatalogRecord &r, int body, int32 ifltype) {
+  return r.body == body && (r.type & ~ifltype) == 0;
+}
+
+void appendRecord(std::map<std::string, std::vector<double>> &result, const CatalogRecord &r) {
+  result["tjd"].push_back(r.tret[0]);
+  result["type"].push_back(r.type);
+  result["magnitude"].push_back(r.magnitude);
+  result["gamma"].push_back(r.gamma);
+  result["sarosSeries"].push_back(r.sarosSeries);
+  result["sarosMember"].push_back(r.sarosMember);
+  auto &tret = result["tret"];
+  tret.insert(tret.end(), r.tret, r.tret + 10);
+}
+
+std::map<std::string, std::vector<double>> emptyResult() {
+  std::map<std::string, std::vector<double>> result;
+  for (const char *key : {"tjd", "type", "magnitude", "gamma", "sarosSeries", "sarosMember", "tret"}) {
+    result[key];
+  }
+  return result;
+}
+
+bool recordBefore(const CatalogRecord &a, const CatalogRecord &b) {
+  return a.tret[0] < b.tret[0];
+}
+
+} // namespace
+
+void swe_eclipse_catalog_build(const std::string &path, double tjd_start, double tjd_end, int iflag) {
+  if (!(tjd_end > tjd_start)) {
+    throw std::runtime_error("tjd_end must be later than tjd_start.");
+  }
+  iflag &= kEpheMask;
+  // slices of at least ten years, solar and lunar searches interleaved
+  size_t nslices = static_cast<size_t>((tjd_end - tjd_start) / 3652.5) + 1;
+  size_t workers = workerCount(nslices * 2);
+  nslices = std::max(nslices, (workers * 4 + 1) / 2);
+  double span = (tjd_end - tjd_start) / nslices;
+  std::vector<std::vector<CatalogRecord>> found(nslices * 2);
+  parallelFor(found.size(), workers, [&](size_t begin, size_t end, size_t) {
+    for (size_t i = begin; i < end; i++) {
+      size_t slice = i / 2;
+      double te = (slice + 1 == nslices) ? tjd_end : tjd_start + (slice + 1) * span;
+      searchSlice(tjd_start + slice * span, te, i % 2 == 0 ? SE_SUN : SE_MOON, iflag, found[i]);
+    }
+  });
+
+  Catalog catalog = {};
+  memcpy(catalog.header.magic, kCatalogMagic, sizeof(kCatalogMagic));
+  catalog.header.version = kCatalogVersion;
+  catalog.header.recordSize = sizeof(CatalogRecord);
+  catalog.header.iflag = iflag;
+  catalog.header.tjdStart = tjd_start;
+  catalog.header.tjdEnd = tjd_end;
+  for (auto &slice : found) {
+    catalog.records.insert(catalog.records.end(), slice.begin(), slice.end());
+  }
+  std::stable_sort(catalog.records.begin(), catalog.records.end(), recordBefore);
+  catalog.header.count = static_cast<int32>(catalog.records.size());
+
+  FILE *fp = fopen(path.c_str(), "wb");
+  if (fp == NULL) {
+    throw std::runtime_error("could not open " + path + " for writing.");
+  }
+  bool ok = fwrite(&catalog.header, sizeof(CatalogHeader), 1, fp) == 1
+    && fwrite(catalog.records.data(), sizeof(CatalogRecord), catalog.records.size(), fp) == catalog.records.size();
+  ok = fclose(fp) == 0 && ok;
+  if (!ok) {
+    throw std::runtime_error("could not write " + path + ".");
+  }
+}
+
+std::map<std::string, std::vector<double>> swe_eclipse_catalog_when(const std::string &file, double tjd_start, int body, int ifltype, bool backward) {
+  auto catalog = loadCatalog(file);
+  int32 wanted = normalizeType(body, ifltype);
+  if (tjd_start < catalog->header.tjdStart || tjd_start > catalog->header.tjdEnd) {
+    throw std::runtime_error("tjd_start is outside of the range of eclipse catalog " + file + ".");
+  }
+  const auto &records = catalog->records;
+  CatalogRecord key = {};
+  key.tret[0] = tjd_start;
+  auto result = emptyResult();
+  if (backward) {
+    auto it = std::lower_bound(records.begin(), records.end(), key, recordBefore);
+    while (it != records.begin()) {
+      --it;
+      if (matches(*it, body, wanted)) {
+        appendRecord(result, *it);
+        return result;
+      }
+    }
+  } else {
+    for (auto it = std::upper_bound(records.begin(), records.end(), key, recordBefore); it != records.end(); ++it) {
+      if (matches(*it, body, wanted)) {
+        appendRecord(result, *it);
+        return result;
+      }
+    }
+  }
+  throw std::runtime_error("no matching eclipse within the range of eclipse catalog " + file + ".");
+}
+
+std::map<std::string, std::vector<double>> swe_eclipse_catalog_range(const std::string &file, double tjd_start, double tjd_end, int body, int ifltype) {
+  auto catalog = loadCatalog(file);
+  int32 wanted = normalizeType(body, ifltype);
+  if (tjd_start < catalog->header.tjdStart || tjd_end > catalog->header.tjdEnd) {
+    throw std::runtime_error("time range is outside of the range of eclipse catalog " + file + ".");
+  }
+  const auto &records = catalog->records;
+  CatalogRecord key = {};
+  key.tret[0] = tjd_start;
+  auto result = emptyResult();
+  for (auto it = std::lower_bound(records.begin(), records.end(), key, recordBefore); it != records.end() && it->tret[0] < tjd_end; ++it) {
+    if (matches(*it, body, wanted)) {
+      appendRecord(result, *it);
+    }
+  }
+  return result;
+}
+
+EclipseTrack EclipseTrack::build(double tjd_start, double tjd_end, int32 iflag) {
+  EclipseTrack track;
+  const double step = 1.0 / 144;
+  iflag = (iflag & kEpheMask) | SEFLG_EQUATORIAL | SEFLG_XYZ;
+  double t0 = tjd_start - 2 * step;
+  int n = static_cast<int>(std::ceil((tjd_end - tjd_start) / step)) + 5;
+  for (int i = 0; i < 3; i++) {
+    for (auto *s : {&track.sun[i], &track.moon[i]}) {
+      s->t0 = t0;
+      s->step = step;
+      s->v.reserve(n);
+    }
+  }
+  track.sidereal.t0 = t0;
+  track.sidereal.step = step;
+  char serr[AS_MAXCH];
+  for (int k = 0; k < n; k++) {
+    double t = t0 + k * step, xs[6], xm[6];
+    if (::swe_calc_ut(t, SE_SUN, iflag, xs, serr) < 0 || ::swe_calc_ut(t, SE_MOON, iflag, xm, serr) < 0) {
+      throw std::runtime_error(serr);
+    }
+    for (int i = 0; i < 3; i++) {
+      track.sun[i].v.push_back(xs[i]);
+      track.moon[i].v.push_back(xm[i]);
+    }
+    auto &sid = track.sidereal.v;
+    double st = ::swe_sidtime(t) * 15;
+    sid.push_back(sid.empty() ? st : sid.back() + diffDeg(st, sid.back()));
+  }
+  return track;
+}
+
+void EclipseTrack::observer(const Observer &obs, double t, double *xobs, double *zenith) const {
+  double theta = (sidereal.at(t) + obs.geopos[0]) * DEGTORAD;
+  double c = std::cos(theta), s = std::sin(theta);
+  xobs[0] = obs.rhoCos * c;
+  xobs[1] = obs.rhoCos * s;
+  xobs[2] = obs.rhoSin;
+  zenith[0] = obs.cosLat * c;
+  zenith[1] = obs.cosLat * s;
+  zenith[2] = obs.sinLat;
+}
+
+int32 SolarCircumstances::phase() const {
+  if (dctr < rsun - rmoon) {
+    return SE_ECL_ANNULAR;
+  }
+  if (dctr < std::fabs(rsun - rmoon)) {
+    return SE_ECL_TOTAL;
+  }
+  return dctr < rsun + rmoon ? SE_ECL_PARTIAL : 0;
+}
+
+double SolarCircumstances::magnitude() const {
+  return phase() ? (rsun + rmoon - dctr) / rsun / 2 : 0;
+}
+
+double SolarCircumstances::obscuration() const {
+  int32 p = phase();
+  if (p & (SE_ECL_TOTAL | SE_ECL_ANNULAR)) {
+    return std::min(1.0, rmoon * rmoon / rsun / rsun);
+  }
+  if (!p) {
+    return 0;
+  }
+  // area of the lens shaped overlap of the two discs
+  double a = (dctr * dctr + rmoon * rmoon - rsun * rsun) / (2 * dctr * rmoon);
+  double b = (dctr * dctr + rsun * rsun - rmoon * rmoon) / (2 * dctr * rsun);
+  a = std::acos(std::max(-1.0, std::min(1.0, a)));
+  b = std::acos(std::max(-1.0, std::min(1.0, b)));
+  double sc1 = (a - std::cos(a) * std::sin(a)) * rmoon * rmoon / 2;
+  double sc2 = (b - std::cos(b) * std::sin(b)) * rsun * rsun / 2;
+  return (sc1 + sc2) * 2 / M_PI / rsun / rsun;
+}
+
+SolarCircumstances solarCircumstances(const EclipseTrack &track, const Observer &obs, double t) {
+  double xo[3], zen[3], xs[3], xm[3];
+  track.observer(obs, t, xo, zen);
+  for (int i = 0; i < 3; i++) {
+    xs[i] = track.sun[i].at(t) - xo[i];
+    xm[i] = track.moon[i].at(t) - xo[i];
+  }
+  double ds = std::sqrt(xs[0] * xs[0] + xs[1] * xs[1] + xs[2] * xs[2]);
+  double dm = std::sqrt(xm[0] * xm[0] + xm[1] * xm[1] + xm[2] * xm[2]);
+  double cross[3] = {xs[1] * xm[2] - xs[2] * xm[1], xs[2] * xm[0] - xs[0] * xm[2], xs[0] * xm[1] - xs[1] * xm[0]};
+  double dot = xs[0] * xm[0] + xs[1] * xm[1] + xs[2] * xm[2];
+  SolarCircumstances c;
+  c.dctr = std::atan2(std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]), dot) * RADTODEG;
+  c.rsun = std::asin(pla_diam[SE_SUN] / 2 / AUNIT / ds) * RADTODEG;
+  c.rmoon = std::asin(kMoonDiameter / 2 / AUNIT / dm) * RADTODEG;
+  c.sunAlt = std::asin((xs[0] * zen[0] + xs[1] * zen[1] + xs[2] * zen[2]) / ds) * RADTODEG;
+  c.moonAlt = std::asin((xm[0] * zen[0] + xm[1] * zen[1] + xm[2] * zen[2]) / dm) * RADTODEG;
+  return c;
+}
+
+namespace {
+
+struct PathPoint {
+  double param; /* sampling time */
+  double t;     /* time of the event at the point */
+  double lon, lat;
+  bool valid;
+};
+
+double separation(const PathPoint &a, const PathPoint &b) {
+  double la = a.lat * DEGTORAD, lb = b.lat * DEGTORAD, dl = (b.lon - a.lon) * DEGTORAD;
+  double c = std::sin(la) * std::sin(lb) + std::cos(la) * std::cos(lb) * std::cos(dl);
+  return std::acos(std::max(-1.0, std::min(1.0, c))) * RADTODEG;
+}
+
+// Samples pointAt(t) on [ta, tb] every `step` days, then bisects intervals in
+// which consecutive points are more than `maxSep` degrees apart or in which
+// the line starts or ends, down to about five seconds.
+template <typename Fn>
+std::vector<PathPoint> tracePath(double ta, double tb, double step, double maxSep, Fn pointAt) {
+  int n = std::max(1, static_cast<int>(std::ceil((tb - ta) / step)));
+  std::vector<PathPoint> coarse(n + 1);
+  parallelFor(coarse.size(), [&](size_t begin, size_t end, size_t) {
+    for (size_t i = begin; i < end; i++) {
+      coarse[i] = pointAt(i == static_cast<size_t>(n) ? tb : ta + i * (tb - ta) / n);
+    }
+  });
+  const double minStep = 5.0 / 86400;
+  std::vector<std::vector<PathPoint>> refined(n);
+  parallelFor(refined.size(), [&](size_t begin, size_t end, size_t) {
+    for (size_t i = begin; i < end; i++) {
+      std::vector<std::pair<PathPoint, PathPoint>> stack = {{coarse[i], coarse[i + 1]}};
+      auto &out = refined[i];
+      while (!stack.empty()) {
+        PathPoint a = stack.back().first, b = stack.back().second;
+        stack.pop_back();
+        bool split = b.param - a.param > minStep && (a.valid != b.valid || (a.valid && separation(a, b) > maxSep));
+        if (!split) {
+          out.push_back(b);
+          continue;
+        }
+        PathPoint m = pointAt(0.5 * (a.param + b.param));
+        // depth first, right half last so that points come out in order
+        stack.push_back({m, b});
+        stack.push_back({a, m});
+      }
+    }
+  });
+  std::vector<PathPoint> path = {coarse[0]};
+  for (auto &r : refined) {
+    path.insert(path.end(), r.begin(), r.end());
+  }
+  return path;
+}
+
+// Appends a polyline as dense tjd/longitude/latitude arrays, with a row of
+// NaNs wherever the line is interrupted.
+void appendPath(std::map<std::string, std::vector<double>> &result, const std::string &name, const std::vector<PathPoint> &path) {
+  auto &tjd = result[name + "Tjd"], &lon = result[name + "Longitude"], &lat = result[name + "Latitude"];
+  for (const auto &p : path) {
+    if (p.valid) {
+      tjd.push_back(p.t);
+      lon.push_back(p.lon);
+      lat.push_back(p.lat);
+    } else if (!tjd.empty() && !std::isnan(tjd.back())) {
+      tjd.push_back(NAN);
+      lon.push_back(NAN);
+      lat.push_back(NAN);
+    }
+  }
+  if (!tjd.empty() && std::isnan(tjd.back())) {
+    tjd.pop_back();
+    lon.pop_back();
+    lat.pop_back();
+  }
+}
+
+// Fundamental plane of a solar eclipse: k points from the Moon towards the
+// Sun, eta towards the celestial north pole, xi completes the frame. x, y
+// locate the shadow axis in Earth radii, (vx, vy) is its unit direction of
+// motion.
+struct ShadowAxis {
+  double k[3], xi[3], eta[3];
+  double x, y;
+  double vx, vy;
+};
+
+void shadowPlane(const EclipseTrack &track, double t, ShadowAxis &a) {
+  double xs[3], xm[3];
+  for (int i = 0; i < 3; i++) {
+    xs[i] = track.sun[i].at(t);
+    xm[i] = track.moon[i].at(t);
+    a.k[i] = xs[i] - xm[i];
+  }
+  double kl = std::sqrt(a.k[0] * a.k[0] + a.k[1] * a.k[1] + a.k[2] * a.k[2]);
+  for (int i = 0; i < 3; i++) {
+    a.k[i] /= kl;
+  }
+  double el = std::sqrt(1 - a.k[2] * a.k[2]);
+  a.eta[0] = -a.k[2] * a.k[0] / el;
+  a.eta[1] = -a.k[2] * a.k[1] / el;
+  a.eta[2] = (1 - a.k[2] * a.k[2]) / el;
+  a.xi[0] = a.eta[1] * a.k[2] - a.eta[2] * a.k[1];
+  a.xi[1] = a.eta[2] * a.k[0] - a.eta[0] * a.k[2];
+  a.xi[2] = a.eta[0] * a.k[1] - a.eta[1] * a.k[0];
+  double er = EARTH_RADIUS / AUNIT;
+  a.x = (xm[0] * a.xi[0] + xm[1] * a.xi[1] + xm[2] * a.xi[2]) / er;
+  a.y = (xm[0] * a.eta[0] + xm[1] * a.eta[1] + xm[2] * a.eta[2]) / er;
+}
+
+ShadowAxis shadowAxis(const EclipseTrack &track, double t) {
+  const double dt = 1.0 / 1440;
+  ShadowAxis a, b;
+  shadowPlane(track, t, a);
+  shadowPlane(track, t + dt, b);
+  double vx = b.x - a.x, vy = b.y - a.y, vl = std::sqrt(vx * vx + vy * vy);
+  a.vx = vx / vl;
+  a.vy = vy / vl;
+  return a;
+}
+
+// Geographic position of the point (X, Y) of the fundamental plane on the
+// sunlit side of the Earth. The Earth is treated as a sphere here; the
+// position only parametrizes the search line, the limit itself is located
+// with the exact circumstances.
+void planeToGeo(const EclipseTrack &track, const ShadowAxis &a, double t, double X, double Y, double *geo) {
+  double Z = std::sqrt(std::max(0.0, 1 - X * X - Y * Y));
+  double p[3];
+  for (int i = 0; i < 3; i++) {
+    p[i] = X * a.xi[i] + Y * a.eta[i] + Z * a.k[i];
+  }
+  double latc = std::asin(std::max(-1.0, std::min(1.0, p[2])));
+  double f = 1 - EARTH_OBLATENESS;
+  geo[0] = ::swe_degnorm(std::atan2(p[1], p[0]) * RADTODEG - track.sidereal.at(t) + 180) - 180;
+  geo[1] = std::atan(std::tan(latc) / (f * f)) * RADTODEG;
+  geo[2] = 0;
+}
+
+enum ShadowEdge { EDGE_UMBRA, EDGE_PENUMBRA };
+
+// Northern (side 1) or southern (side -1) limit of the umbra or penumbra at
+// time t: the point on the line through the shadow axis, across its motion,
+// at which the deepest phase seen during the eclipse is just the edge of the
+// shadow.
+PathPoint shadowLimit(const EclipseTrack &track, double t, ShadowEdge edge, int side, double ts, double te) {
+  PathPoint none = {t, t, 0, 0, false};
+  ShadowAxis a = shadowAxis(track, t);
+  // across the motion, pointing north
+  double nx = -a.vy, ny = a.vx;
+  if (ny < 0) {
+    nx = -nx;
+    ny = -ny;
+  }
+  // part of the line on the Earth's disc: |(x, y) + s n| < 1
+  double pb = a.x * nx + a.y * ny, pc = a.x * a.x + a.y * a.y - 1;
+  double disc = pb * pb - pc;
+  if (disc <= 0) {
+    return none;
+  }
+  double smin = -pb - std::sqrt(disc) + 1e-9, smax = -pb + std::sqrt(disc) - 1e-9;
+  double tmax = t;
+  auto depth = [&](double s) {
+    double geo[3];
+    planeToGeo(track, a, t, a.x + s * nx, a.y + s * ny, geo);
+    Observer obs(geo, 0, 0, SE_BIT_NO_REFRACTION);
+    double fmin;
+    tmax = minimizeTime([&](double tt) {
+      SolarCircumstances c = solarCircumstances(track, obs, tt);
+      return c.dctr - (edge == EDGE_UMBRA ? std::fabs(c.rsun - c.rmoon) : c.rsun + c.rmoon);
+    }, std::max(ts, t - 0.1), std::min(te, t + 0.1), 9, &fmin);
+    return fmin;
+  };
+  double s = std::max(smin, std::min(smax, 0.0));
+  double fs = depth(s);
+  if (fs >= 0) {
+    return none;
+  }
+  double step = edge == EDGE_UMBRA ? 0.004 : 0.04;
+  for (;;) {
+    double sn = s + side * step;
+    bool last = side > 0 ? sn >= smax : sn <= smin;
+    if (last) {
+      sn = side > 0 ? smax : smin;
+    }
+    double fn = depth(sn);
+    if (fn >= 0) {
+      double root = findRoot(depth, s, fs, sn, fn, 1e-6);
+      double geo[3];
+      depth(root);
+      planeToGeo(track, a, t, a.x + root * nx, a.y + root * ny, geo);
+      return {t, tmax, geo[0], geo[1], true};
+    }
+    if (last) {
+      return none;
+    }
+    s = sn;
+    fs = fn;
+  }
+}
+
+} // namespace
+
+// Map of the solar eclipse with maximum within a day of tjd_ut: the central
+// line and the limits of umbra and penumbra as polylines (NaN rows separate
+// pieces), and the greatest phase over a grid with latitude rows from -90
+// and longitude columns from -180.
+std::map<std::string, std::vector<double>> swe_sol_eclipse_map(double tjd_ut, int iflag, double lon_step, double lat_step) {
+  if (!(lon_step > 0) || !(lat_step > 0)) {
+    throw std::runtime_error("grid steps must be positive.");
+  }
+  iflag &= kEpheMask;
+  double tret[10];
+  char serr[AS_MAXCH];
+  int32 type = ::swe_sol_eclipse_when_glob(tjd_ut - 1, iflag, 0, tret, 0, serr);
+  if (type < 0) {
+    throw std::runtime_error(serr);
+  }
+  if (std::fabs(tret[0] - tjd_ut) > 1) {
+    throw std::runtime_error("no solar eclipse within a day of tjd_ut.");
+  }
+  double ts = tret[2], te = tret[3];
+  EclipseTrack track = EclipseTrack::build(ts - 0.05, te + 0.05, iflag);
+
+  std::map<std::string, std::vector<double>> result;
+  result["tret"].assign(tret, tret + 10);
+  result["type"] = {static_cast<double>(type & SE_ECL_ALLTYPES_SOLAR)};
+
+  const double step = 5.0 / 1440;
+  const double maxSep = 1;
+  std::vector<PathPoint> central;
+  if (type & SE_ECL_CENTRAL) {
+    central = tracePath(tret[6], tret[7], step, maxSep, [&](double t) {
+      double geopos[10], attr[20];
+      char err[AS_MAXCH];
+      int32 ret = ::swe_sol_eclipse_where(t, iflag, geopos, attr, err);
+      if (ret < 0) {
+        throw std::runtime_error(err);
+      }
+      return PathPoint{t, t, geopos[0], geopos[1], (ret & SE_ECL_CENTRAL) != 0};
+    });
+  }
+  appendPath(result, "central", central);
+  const std::pair<const char *, std::pair<ShadowEdge, int>> limits[] = {
+    {"umbraNorth", {EDGE_UMBRA, 1}},
+    {"umbraSouth", {EDGE_UMBRA, -1}},
+    {"penumbraNorth", {EDGE_PENUMBRA, 1}},
+    {"penumbraSouth", {EDGE_PENUMBRA, -1}},
+  };
+  for (const auto &limit : limits) {
+    std::vector<PathPoint> path;
+    if (limit.second.first == EDGE_PENUMBRA || (type & (SE_ECL_TOTAL | SE_ECL_ANNULAR | SE_ECL_ANNULAR_TOTAL))) {
+      path = tracePath(ts, te, step, maxSep, [&](double t) {
+        return shadowLimit(track, t, limit.second.first, limit.second.second, ts, te);
+      });
+    }
+    appendPath(result, limit.first, path);
+  }
+
+  // raster of the greatest phase seen from each grid point
+  int nlon = static_cast<int>(std::floor(360 / lon_step + 1e-9));
+  int nlat = static_cast<int>(std::floor(180 / lat_step + 1e-9)) + 1;
+  auto &gridLon = result["gridLongitude"], &gridLat = result["gridLatitude"];
+  for (int i = 0; i < nlon; i++) {
+    gridLon.push_back(-180 + i * lon_step);
+  }
+  for (int j = 0; j < nlat; j++) {
+    gridLat.push_back(-90 + j * lat_step);
+  }
+  size_t ncell = static_cast<size_t>(nlon) * nlat;
+  auto &magnitude = result["magnitude"], &obscuration = result["obscuration"];
+  auto &maxTjd = result["maxTjd"], &sunAltitude = result["sunAltitude"];
+  magnitude.assign(ncell, 0);
+  obscuration.assign(ncell, 0);
+  maxTjd.assign(ncell, NAN);
+  sunAltitude.assign(ncell, NAN);
+  parallelFor(nlat, [&](size_t begin, size_t end, size_t) {
+    for (size_t j = begin; j < end; j++) {
+      for (int i = 0; i < nlon; i++) {
+        double geo[3] = {gridLon[i], gridLat[j], 0};
+        Observer obs(geo, 0, 0, SE_BIT_NO_REFRACTION);
+        double fmin;
+        double t = minimizeTime([&](double tt) {
+          SolarCircumstances c = solarCircumstances(track, obs, tt);
+          return c.dctr - c.rsun - c.rmoon;
+        }, ts, te, 13, &fmin);
+        if (fmin >= 0) {
+          continue;
+        }
+        SolarCircumstances c = solarCircumstances(track, obs, t);
+        size_t idx = j * nlon + i;
+        magnitude[idx] = c.magnitude();
+        obscuration[idx] = c.obscuration();
+        maxTjd[idx] = t;
+        sunAltitude[idx] = c.sunAlt;
+      }
+    }
+  });
+  return result;
+}
+
+namespace {
+
+// Circumstances of one eclipse at one site; tret[] and type as returned by
+// swe_sol_eclipse_when_loc() and swe_lun_eclipse_when_loc(), with NaN for
+// the missing times. magnitude is attr[0] of these functions, the fraction
+// of the diameter covered; diameterRatio, attr[1] of solar eclipses, is the
+// magnitude that NASA quotes for total and annular phases.
+struct LocalEclipse {
+  double tret[10];
+  int32 type = 0;
+  double magnitude = NAN, penumbralMagnitude = NAN, obscuration = NAN;
+  double diameterRatio = NAN;
+  double sunAlt = NAN, moonAlt = NAN;
+};
+
+// First crossings of zero by f in [ta, tb], upwards and downwards, located
+// from samples `step` apart.
+template <typename Fn>
+void findCrossings(Fn f, double ta, double tb, double step, double *up, double *down) {
+  int n = std::max(1, static_cast<int>(std::ceil((tb - ta) / step)));
+  double t0 = ta, f0 = f(ta);
+  for (int i = 1; i <= n; i++) {
+    double t1 = std::min(tb, ta + i * step), f1 = f(t1);
+    double *out = f0 < 0 ? up : down;
+    if ((f0 < 0) != (f1 < 0) && std::isnan(*out)) {
+      *out = findRoot(f, t0, f0, t1, f1, 1e-6);
+    }
+    t0 = t1;
+    f0 = f1;
+  }
+}
+
+// Follows eclipse_when_loc() in swecl.c, with the Sun and the Moon taken from
+// the shared track; ts and te are the first and last contact anywhere on
+// Earth.
+LocalEclipse solarLocal(const EclipseTrack &track, const std::vector<int32> &noncentral, const Observer &obs,
+                        const Observer &riseObs, double ts, double te, int32 iflag) {
+  LocalEclipse e;
+  std::fill(e.tret, e.tret + 10, NAN);
+  auto at = [&](double t) { return solarCircumstances(track, obs, t); };
+  double fmin;
+  double tmax = minimizeTime([&](double t) { return at(t).dctr; }, ts, te,
+                             static_cast<int>((te - ts) * 144) + 3, &fmin);
+  SolarCircumstances c = at(tmax);
+  int32 phase = c.phase();
+  if (!phase) {
+    return e;
+  }
+  e.tret[0] = tmax;
+  auto outer = [&](double t) {
+    SolarCircumstances ct = at(t);
+    return ct.dctr - ct.rsun - ct.rmoon;
+  };
+  double fa = outer(ts), fb = outer(te), fm = outer(tmax);
+  e.tret[1] = fa > 0 ? findRoot(outer, ts, fa, tmax, fm, 1e-6) : ts;
+  e.tret[4] = fb > 0 ? findRoot(outer, tmax, fm, te, fb, 1e-6) : te;
+  if (phase & (SE_ECL_TOTAL | SE_ECL_ANNULAR)) {
+    // same reduction of the lunar radius as swecl.c for these contacts
+    auto inner = [&](double t) {
+      SolarCircumstances ct = at(t);
+      return ct.dctr - std::fabs(ct.rsun - ct.rmoon * 0.99916);
+    };
+    double gm = inner(tmax);
+    if (gm < 0) {
+      e.tret[2] = findRoot(inner, e.tret[1], inner(e.tret[1]), tmax, gm, 1e-6);
+      e.tret[3] = findRoot(inner, tmax, gm, e.tret[4], inner(e.tret[4]), 1e-6);
+    }
+  }
+  int32 type = phase;
+  const int32 contactFlags[5] = {SE_ECL_MAX_VISIBLE, SE_ECL_1ST_VISIBLE, SE_ECL_2ND_VISIBLE, SE_ECL_3RD_VISIBLE, SE_ECL_4TH_VISIBLE};
+  for (int i = 0; i <= 4; i++) {
+    // apparent altitude above 0
+    if (!std::isnan(e.tret[i]) && at(e.tret[i]).sunAlt > obs.horizon) {
+      type |= SE_ECL_VISIBLE | contactFlags[i];
+    }
+  }
+  if (!(type & SE_ECL_VISIBLE)) {
+    std::fill(e.tret, e.tret + 10, NAN);
+    return e;
+  }
+  // rising and setting of the lower limb, as swe_rise_trans() with
+  // SE_BIT_DISC_BOTTOM
+  auto limb = [&](double t) {
+    SolarCircumstances ct = at(t);
+    return ct.sunAlt - ct.rsun - riseObs.horizon;
+  };
+  findCrossings(limb, e.tret[1] - 0.001, e.tret[4], 1.0 / 144, &e.tret[5], &e.tret[6]);
+  // no eclipse if the Sun sets as it begins or the lower limb stays below
+  // the horizon throughout
+  if (e.tret[6] < e.tret[1] || (std::isnan(e.tret[5]) && std::isnan(e.tret[6]) && limb(e.tret[1] - 0.001) < 0)) {
+    std::fill(e.tret, e.tret + 10, NAN);
+    return e;
+  }
+  if (e.tret[5] < e.tret[1]) {
+    e.tret[5] = NAN;
+  }
+  double tvis = e.tret[0];
+  if (!(type & SE_ECL_MAX_VISIBLE)) {
+    tvis = !std::isnan(e.tret[6]) ? e.tret[6] : !std::isnan(e.tret[5]) ? e.tret[5] : tvis;
+  }
+  c = at(tvis);
+  e.tret[0] = tvis;
+  size_t k = std::min(noncentral.size() - 2, static_cast<size_t>(std::max(0.0, std::floor((tvis - ts) * 1440))));
+  int32 central = noncentral[k];
+  if (central != noncentral[k + 1]) {
+    double geo[10], attr[20];
+    char serr[AS_MAXCH];
+    int32 ret = ::swe_sol_eclipse_where(tvis, iflag, geo, attr, serr);
+    if (ret < 0) {
+      throw std::runtime_error(serr);
+    }
+    central = ret & SE_ECL_NONCENTRAL;
+  }
+  e.type = (type & ~SE_ECL_ALLTYPES_SOLAR) | c.phase() | central;
+  e.magnitude = c.magnitude();
+  e.diameterRatio = c.rmoon / c.rsun;
+  e.obscuration = c.obscuration();
+  e.sunAlt = c.sunAlt;
+  e.moonAlt = c.moonAlt;
+  return e;
+}
+
+// Follows swe_lun_eclipse_when_loc(): the contacts are those of the
+// geocentric eclipse in `global`, only their visibility depends on the site.
+LocalEclipse lunarLocal(const double *global, int32 globalType, const double *globalAttr, const BodyTrack &moon,
+                        const BodyTrack &sun, const SiderealTrack &sid, const Observer &obs, const Observer &riseObs,
+                        int32 iflag) {
+  LocalEclipse e;
+  double tret[10];
+  std::copy(global, global + 10, tret);
+  int32 type = 0;
+  const int32 phaseFlags[8] = {SE_ECL_MAX_VISIBLE, 0, SE_ECL_PARTBEG_VISIBLE, SE_ECL_PARTEND_VISIBLE,
+                               SE_ECL_TOTBEG_VISIBLE, SE_ECL_TOTEND_VISIBLE, SE_ECL_PENUMBBEG_VISIBLE,
+                               SE_ECL_PENUMBEND_VISIBLE};
+  for (int i = 0; i <= 7; i++) {
+    if (i != 1 && tret[i] != 0 && topocentric(moon, sid, obs, tret[i]).alt > obs.horizon) {
+      type |= SE_ECL_VISIBLE | phaseFlags[i];
+    }
+  }
+  if (!(type & SE_ECL_VISIBLE)) {
+    std::fill(e.tret, e.tret + 10, NAN);
+    return e;
+  }
+  double rise = NAN, set = NAN;
+  findHorizonEvents(moon, sid, riseObs, SE_BIT_DISC_BOTTOM, tret[6] - 0.001, tret[7], [&](int event, double t) {
+    if (event == HORIZON_RISE && std::isnan(rise)) {
+      rise = t;
+    } else if (event == HORIZON_SET && std::isnan(set)) {
+      set = t;
+    }
+  });
+  // as above for the Moon
+  if (set < tret[6] ||
+      (std::isnan(rise) && std::isnan(set) &&
+       horizonOffset(moon, riseObs, SE_BIT_DISC_BOTTOM, topocentric(moon, sid, riseObs, tret[6])) < 0)) {
+    std::fill(e.tret, e.tret + 10, NAN);
+    return e;
+  }
+  double tmax = tret[0];
+  if (!std::isnan(rise) && rise > tret[6]) {
+    tret[6] = 0;
+    for (int i = 2; i <= 5; i++) {
+      if (rise > tret[i]) {
+        tret[i] = 0;
+      }
+    }
+    tret[8] = rise;
+    if (rise > tret[0]) {
+      tmax = rise;
+    }
+  }
+  if (!std::isnan(set) && set > tret[6]) {
+    tret[7] = 0;
+    for (int i = 2; i <= 5; i++) {
+      if (set < tret[i]) {
+        tret[i] = 0;
+      }
+    }
+    tret[9] = set;
+    if (set < tret[0]) {
+      tmax = set;
+    }
+  }
+  tret[0] = tmax;
+  double attr[20];
+  int32 phase = globalType;
+  if (tmax == global[0]) {
+    std::copy(globalAttr, globalAttr + 20, attr);
+  } else {
+    char serr[AS_MAXCH];
+    phase = ::swe_lun_eclipse_how(tmax, iflag, NULL, attr, serr);
+    if (phase < 0) {
+      throw std::runtime_error(serr);
+    }
+  }
+  TopoPosition pm = topocentric(moon, sid, obs, tmax);
+  if (!(phase & SE_ECL_ALLTYPES_LUNAR) || pm.alt <= obs.horizon) {
+    std::fill(e.tret, e.tret + 10, NAN);
+    return e;
+  }
+  for (int i = 0; i < 10; i++) {
+    e.tret[i] = tret[i] != 0 ? tret[i] : NAN;
+  }
+  e.type = type | (phase & SE_ECL_ALLTYPES_LUNAR);
+  e.magnitude = attr[0];
+  e.penumbralMagnitude = attr[1];
+  e.moonAlt = pm.alt;
+  e.sunAlt = topocentric(sun, sid, obs, tmax).alt;
+  return e;
+}
+
+} // namespace
+
+// Local circumstances of the solar (SE_SUN) or lunar (SE_MOON) eclipse with
+// maximum within a day of tjd_ut, for each location in geopos (longitude,
+// latitude, height triples). Positions of the Sun and the Moon are computed
+// once for the eclipse and shared by all locations. type is 0 where the
+// eclipse cannot be seen.
+std::map<std::string, std::vector<double>> swe_eclipse_when_loc_batch(double tjd_ut, int body, const std::vector<double> &geopos, int iflag) {
+  if (body != SE_SUN && body != SE_MOON) {
+    throw std::runtime_error("body must be SE_SUN or SE_MOON.");
+  }
+  if (geopos.size() % 3 != 0) {
+    throw std::runtime_error("geopos must hold longitude, latitude and height for each location.");
+  }
+  size_t nloc = geopos.size() / 3;
+  for (size_t m = 0; m < nloc; m++) {
+    if (geopos[3 * m + 2] < SEI_ECL_GEOALT_MIN || geopos[3 * m + 2] > SEI_ECL_GEOALT_MAX) {
+      throw std::runtime_error("location height must be between -500 and 25000 m above sea.");
+    }
+  }
+  iflag &= kEpheMask;
+  double tret[10], attr[20];
+  char serr[AS_MAXCH];
+  int32 type = body == SE_SUN ? ::swe_sol_eclipse_when_glob(tjd_ut - 1, iflag, 0, tret, 0, serr)
+                              : ::swe_lun_eclipse_when(tjd_ut - 1, iflag, 0, tret, 0, serr);
+  if (type < 0) {
+    throw std::runtime_error(serr);
+  }
+  if (std::fabs(tret[0] - tjd_ut) > 1) {
+    throw std::runtime_error(body == SE_SUN ? "no solar eclipse within a day of tjd_ut." : "no lunar eclipse within a day of tjd_ut.");
+  }
+
+  std::vector<LocalEclipse> local(nloc);
+  if (body == SE_SUN) {
+    double ts = tret[2], te = tret[3];
+    EclipseTrack track = EclipseTrack::build(ts - 0.05, te + 0.05, iflag);
+    // swe_sol_eclipse_when_loc() adds SE_ECL_NONCENTRAL when the shadow axis
+    // misses the Earth at the local maximum; tabulated by the minute
+    std::vector<int32> noncentral(static_cast<size_t>((te - ts) * 1440) + 2);
+    for (size_t k = 0; k < noncentral.size(); k++) {
+      double geo[10], dummy[20];
+      int32 ret = ::swe_sol_eclipse_where(ts + k / 1440.0, iflag, geo, dummy, serr);
+      if (ret < 0) {
+        throw std::runtime_error(serr);
+      }
+      noncentral[k] = ret & SE_ECL_NONCENTRAL;
+    }
+    parallelFor(nloc, [&](size_t begin, size_t end, size_t) {
+      for (size_t m = begin; m < end; m++) {
+        // pressure and temperature as used by eclipse_how() and by the
+        // swe_rise_trans() calls of swecl.c
+        Observer obs(&geopos[3 * m], 0, 10, 0), riseObs(&geopos[3 * m], 0, 0, 0);
+        local[m] = solarLocal(track, noncentral, obs, riseObs, ts, te, iflag);
+      }
+    });
+  } else {
+    int32 phase = ::swe_lun_eclipse_how(tret[0], iflag, NULL, attr, serr);
+    if (phase < 0) {
+      throw std::runtime_error(serr);
+    }
+    BodyTrack moon = BodyTrack::build(SE_MOON, "", tret[6] - 0.1, tret[7] + 0.1, iflag);
+    BodyTrack sun = BodyTrack::build(SE_SUN, "", tret[6] - 0.1, tret[7] + 0.1, iflag);
+    SiderealTrack sid = SiderealTrack::build(tret[6] - 0.1, tret[7] + 0.1, 1.0 / 24);
+    parallelFor(nloc, [&](size_t begin, size_t end, size_t) {
+      for (size_t m = begin; m < end; m++) {
+        Observer obs(&geopos[3 * m], 0, 10, 0), riseObs(&geopos[3 * m], 0, 0, 0);
+        local[m] = lunarLocal(tret, phase, attr, moon, sun, sid, obs, riseObs, iflag);
+      }
+    });
+  }
+
+  std::map<std::string, std::vector<double>> result;
+  auto &types = result["type"], &times = result["tret"];
+  auto &magnitude = result["magnitude"], &penumbral = result["penumbralMagnitude"];
+  auto &obscuration = result["obscuration"], &diameterRatio = result["diameterRatio"];
+  auto &sunAltitude = result["sunAltitude"], &moonAltitude = result["moonAltitude"];
+  for (const auto &e : local) {
+    types.push_back(e.type);
+    times.insert(times.end(), e.tret, e.tret + 10);
+    magnitude.push_back(e.magnitude);
+    penumbral.push_back(e.penumbralMagnitude);
+    obscuration.push_back(e.obscuration);
+    diameterRatio.push_back(e.diameterRatio);
+    sunAltitude.push_back(e.sunAlt);
+    moonAltitude.push_back(e.moonAlt);
+  }
+  return result;
+}
+
+} // namespace swisseph
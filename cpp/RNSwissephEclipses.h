@@ -0,0 +1,81 @@
+#ifndef SWISSEPH_ECLIPSES_H
+#define SWISSEPH_ECLIPSES_H
+#include "RNSwissephHorizon.h"
+
+namespace swisseph {
+
+// Apparent geocentric equatorial positions of the Sun and the Moon around a
+// solar eclipse. Computed once and shared by every location.
+struct EclipseTrack {
+  SampledSeries sun[3], moon[3]; /* cartesian, AU */
+  SampledSeries sidereal;        /* Greenwich apparent sidereal time in degrees, unwrapped */
+
+  static EclipseTrack build(double tjd_start, double tjd_end, int32 iflag);
+
+  // Observer position and zenith direction in the frame of the track.
+  void observer(const Observer &obs, double t, double *xobs, double *zenith) const;
+};
+
+// Topocentric circumstances of a solar eclipse at one instant, with the
+// definitions of eclipse_how() in swecl.c.
+struct SolarCircumstances {
+  double dctr;   /* distance between the centers of Sun and Moon, degrees */
+  double rsun;   /* apparent radii, degrees */
+  double rmoon;
+  double sunAlt; /* true altitudes of the centers */
+  double moonAlt;
+
+  int32 phase() const;          /* SE_ECL_TOTAL, SE_ECL_ANNULAR, SE_ECL_PARTIAL or 0 */
+  double magnitude() const;     /* fraction of the solar diameter covered, attr[0] */
+  double obscuration() const;   /* fraction of the solar disc covered, attr[2] */
+};
+
+SolarCircumstances solarCircumstances(const EclipseTrack &track, const Observer &obs, double t);
+
+// Time in [ta, tb] at which f(t) is smallest, for functions with a single
+// minimum: a scan of `nscan` samples followed by a golden section search
+// around the best one.
+template <typename Fn>
+double minimizeTime(Fn f, double ta, double tb, int nscan, double *fmin) {
+  double step = (tb - ta) / (nscan - 1);
+  int best = 0;
+  double fbest = f(ta);
+  for (int i = 1; i < nscan; i++) {
+    double fi = f(ta + i * step);
+    if (fi < fbest) {
+      best = i;
+      fbest = fi;
+    }
+  }
+  double a = std::max(ta, ta + (best - 1) * step), b = std::min(tb, ta + (best + 1) * step);
+  double m1 = b - 0.618034 * (b - a), m2 = a + 0.618034 * (b - a);
+  double f1 = f(m1), f2 = f(m2);
+  // 1e-6 days is well below a second
+  while (b - a > 1e-6) {
+    if (f1 < f2) {
+      b = m2;
+      m2 = m1;
+      f2 = f1;
+      m1 = b - 0.618034 * (b - a);
+      f1 = f(m1);
+    } else {
+      a = m1;
+      m1 = m2;
+      f1 = f2;
+      m2 = a + 0.618034 * (b - a);
+      f2 = f(m2);
+    }
+  }
+  double t = 0.5 * (a + b);
+  double ft = f(t);
+  if (ft > fbest) {
+    t = ta + best * step;
+    ft = fbest;
+  }
+  *fmin = ft;
+  return t;
+}
+
+} // namespace swisseph
+
+#endif /* SWISSEPH_ECLIPSES_H */
@@ -0,0 +1,251 @@
+#include "RNSwissephStars.h"
+#include <cctype>
+#include <cstring>
+#include <set>
+
+namespace swisseph {
+
+namespace {
+
+// swehel.c fills in defaults for missing atmospheric and observer values.
+void padHeliacalArgs(std::vector<double> &datm, std::vector<double> &dobs) {
+  datm.resize(std::max<size_t>(datm.size(), 4), 0);
+  dobs.resize(std::max<size_t>(dobs.size(), 6), 0);
+}
+
+void padHeliacalArgs(std::vector<double> &dgeo, std::vector<double> &datm, std::vector<double> &dobs) {
+  dgeo.resize(std::max<size_t>(dgeo.size(), 3), 0);
+  padHeliacalArgs(datm, dobs);
+}
+
+// Traditional name of a catalog entry ("Aldebaran,alTau") if swehel.c can
+// address the star by it: the heliacal functions copy only alphanumerics,
+// blanks and '-' (at most 30 of them) and take names starting like a planet
+// or with a digit for a planet or an asteroid.
+std::string heliacalStarName(const char *fullname) {
+  std::string name(fullname, std::strcspn(fullname, ","));
+  while (!name.empty() && name.back() == ' ') {
+    name.pop_back();
+  }
+  if (name.empty() || name.size() > 30 || std::isdigit(static_cast<unsigned char>(name[0]))) {
+    return "";
+  }
+  std::string lower;
+  for (char c : name) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != ' ' && c != '-') {
+      return "";
+    }
+    lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  for (const char *planet : {"sun", "moon", "mercur", "venus", "mars", "jupiter", "saturn", "uranus", "neptun"}) {
+    if (lower.compare(0, std::strlen(planet), planet) == 0) {
+      return "";
+    }
+  }
+  return name;
+}
+
+struct CatalogStar {
+  std::string name;
+  double magnitude;
+};
+
+// Lookup key of the traditional name: the library compares names without
+// blanks and in lower case, and takes the first entry the key is a prefix of.
+std::string starKey(const std::string &name) {
+  std::string key;
+  for (char c : name.substr(0, name.find(','))) {
+    if (c != ' ') {
+      key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+  }
+  return key;
+}
+
+// Stars of the catalog file not fainter than maglimit, in catalog order. A
+// name that is found earlier in the file under another entry is left out.
+std::vector<CatalogStar> catalogStars(double maglimit) {
+  std::vector<CatalogStar> stars;
+  if (maglimit < kBrightestStar) {
+    return stars;
+  }
+  std::vector<CatalogEntry> entries = readStarCatalog();
+  std::vector<std::string> keys;
+  keys.reserve(entries.size());
+  for (const auto &entry : entries) {
+    keys.push_back(starKey(entry.name));
+  }
+  std::set<std::string> seen;
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (!(entries[i].magnitude <= maglimit)) {
+      continue;
+    }
+    std::string name = heliacalStarName(entries[i].name.c_str());
+    if (name.empty() || !seen.insert(name).second) {
+      continue;
+    }
+    std::string key = starKey(name);
+    bool shadowed = false;
+    for (size_t j = 0; j < i && !shadowed; j++) {
+      shadowed = keys[j].compare(0, key.size(), key) == 0;
+    }
+    if (!shadowed) {
+      stars.push_back({name, entries[i].magnitude});
+    }
+  }
+  return stars;
+}
+
+// Keeps the memoization tables of swehel.c for all searches of one worker.
+struct HeliacalCacheScope {
+  HeliacalCacheScope() { ::swi_heliacal_cache_open(); }
+  ~HeliacalCacheScope() { ::swi_heliacal_cache_close(); }
+};
+
+} // namespace
+
+std::map<std::string, std::vector<double>> swe_vis_limit_mag_grid(double tjd_ut, std::vector<double> dgeo, std::vector<double> datm, std::vector<double> dobs,
+                                                                  int helflag, const std::vector<double> &azimuths, const std::vector<double> &altitudes) {
+  padHeliacalArgs(dgeo, datm, dobs);
+  // altitude in the outer loop: swehel.c reuses the extinction along a row
+  std::vector<double> points;
+  points.reserve(2 * azimuths.size() * altitudes.size());
+  for (double alt : altitudes) {
+    for (double azi : azimuths) {
+      points.push_back(azi);
+      points.push_back(alt);
+    }
+  }
+  size_t npoints = points.size() / 2;
+  std::vector<double> dret(npoints * SE_VISLIM_GRID_NVAL);
+  char serr[AS_MAXCH] = "";
+  if (::swe_vis_limit_mag_grid(tjd_ut, dgeo.data(), datm.data(), dobs.data(), helflag, static_cast<int32>(npoints),
+                               points.data(), dret.data(), serr) < 0) {
+    throw std::runtime_error(serr);
+  }
+  std::map<std::string, std::vector<double>> result;
+  auto &magnitude = result["magnitude"], &skyBrightness = result["skyBrightness"];
+  auto &extinction = result["extinction"], &airmass = result["airmass"], &flag = result["flag"];
+  for (size_t i = 0; i < npoints; i++) {
+    const double *d = &dret[i * SE_VISLIM_GRID_NVAL];
+    magnitude.push_back(d[0]);
+    skyBrightness.push_back(d[1]);
+    extinction.push_back(d[2]);
+    airmass.push_back(d[3]);
+    flag.push_back(d[4]);
+  }
+  return result;
+}
+
+HeliacalCalendar swe_heliacal_calendar(double tjd_start, double tjd_end, std::vector<double> dgeo, std::vector<double> datm, std::vector<double> dobs,
+                                       double maglimit, const std::vector<int> &events, int helflag) {
+  if (!(tjd_end > tjd_start)) {
+    throw std::runtime_error("tjd_end must be later than tjd_start.");
+  }
+  padHeliacalArgs(dgeo, datm, dobs);
+  std::vector<int> types = events;
+  if (types.empty()) {
+    types = {SE_HELIACAL_RISING, SE_HELIACAL_SETTING};
+  }
+  std::vector<CatalogStar> stars = catalogStars(maglimit);
+
+  struct Found {
+    double tjd, optimum, end;
+    int star, event;
+  };
+  // one job per star, so that all searches for a star run on one worker and
+  // share its memoization tables
+  std::vector<std::vector<Found>> found(stars.size());
+  parallelFor(stars.size(), [&](size_t begin, size_t end, size_t) {
+    HeliacalCacheScope cache;
+    std::vector<double> geo = dgeo, atm = datm, obs = dobs;
+    for (size_t istar = begin; istar < end; istar++) {
+      for (int type : types) {
+        double t = tjd_start;
+        while (t < tjd_end) {
+          char name[AS_MAXCH], serr[AS_MAXCH] = "";
+          double dret[50] = {0};
+          std::strncpy(name, stars[istar].name.c_str(), AS_MAXCH - 1);
+          name[AS_MAXCH - 1] = '\0';
+          // an error means that the event does not exist for this star and
+          // location (circumpolar, never rising, event type not defined)
+          if (::swe_heliacal_ut(t, geo.data(), atm.data(), obs.data(), name, type, helflag, dret, serr) < 0 ||
+              dret[0] < t || dret[0] >= tjd_end) {
+            break;
+          }
+          found[istar].push_back({dret[0], dret[1], dret[2], static_cast<int>(istar), type});
+          t = dret[0] + 1;
+        }
+      }
+    }
+  });
+
+  std::vector<Found> merged;
+  for (auto &f : found) {
+    merged.insert(merged.end(), f.begin(), f.end());
+  }
+  std::stable_sort(merged.begin(), merged.end(), [](const Found &a, const Found &b) { return a.tjd < b.tjd; });
+  HeliacalCalendar result;
+  for (const auto &s : stars) {
+    result.stars.push_back(s.name);
+    result.magnitudes.push_back(s.magnitude);
+  }
+  auto &tjd = result.events["tjd"], &optimum = result.events["optimum"], &last = result.events["end"];
+  auto &star = result.events["star"], &event = result.events["event"];
+  for (const auto &f : merged) {
+    tjd.push_back(f.tjd);
+    optimum.push_back(f.optimum);
+    last.push_back(f.end);
+    star.push_back(f.star);
+    event.push_back(f.event);
+  }
+  return result;
+}
+
+std::map<std::string, std::vector<double>> swe_heliacal_pheno_batch(const std::vector<double> &tjd_ut, const std::vector<double> &geopos,
+                                                                    std::vector<double> datm, std::vector<double> dobs,
+                                                                    const std::string &object_name, int event_type, int helflag) {
+  if (geopos.size() % 3 != 0) {
+    throw std::runtime_error("geopos must hold longitude, latitude and altitude triples.");
+  }
+  // a single date or a single location is used for every pair
+  size_t nloc = geopos.size() / 3;
+  size_t n = std::max(tjd_ut.size(), nloc);
+  if ((tjd_ut.size() != n && tjd_ut.size() != 1) || (nloc != n && nloc != 1)) {
+    throw std::runtime_error("tjd_ut and geopos must describe the same number of pairs.");
+  }
+  padHeliacalArgs(datm, dobs);
+  std::vector<double> values(n * kHeliacalPhenoCount, NAN);
+  std::vector<double> retflag(n, ERR);
+  parallelFor(n, [&](size_t begin, size_t end, size_t) {
+    // swehel.c may write defaults into the atmosphere and observer arrays
+    std::vector<double> atm = datm, obs = dobs;
+    for (size_t i = begin; i < end; i++) {
+      double geo[3], darr[50];
+      char name[AS_MAXCH], serr[AS_MAXCH] = "";
+      const double *g = &geopos[3 * (nloc == 1 ? 0 : i)];
+      std::copy(g, g + 3, geo);
+      std::copy(datm.begin(), datm.end(), atm.begin());
+      std::copy(dobs.begin(), dobs.end(), obs.begin());
+      std::strncpy(name, object_name.c_str(), AS_MAXCH - 1);
+      name[AS_MAXCH - 1] = '\0';
+      double tjd = tjd_ut[tjd_ut.size() == 1 ? 0 : i];
+      retflag[i] = ::swe_heliacal_pheno_ut(tjd, geo, atm.data(), obs.data(), name, event_type, helflag, darr, serr);
+      if (retflag[i] >= 0) {
+        std::copy(darr, darr + kHeliacalPhenoCount, &values[i * kHeliacalPhenoCount]);
+      }
+    }
+  });
+  std::map<std::string, std::vector<double>> result;
+  for (size_t k = 0; k < kHeliacalPhenoCount; k++) {
+    auto &column = result[kHeliacalPhenoKeys[k]];
+    column.resize(n);
+    for (size_t i = 0; i < n; i++) {
+      column[i] = values[i * kHeliacalPhenoCount + k];
+    }
+  }
+  result["retflag"] = retflag;
+  return result;
+}
+
+} // namespace swisseph
@@ -0,0 +1,494 @@
+#include "RNSwissephHorizon.h"
+#include <cstring>
+#include <memory>
+
+namespace swisseph {
+
+namespace {
+
+constexpr int32 kEpheMask = SEFLG_JPLEPH | SEFLG_SWIEPH | SEFLG_MOSEPH;
+
+void appendUnwrapped(std::vector<double> &v, double deg) {
+  if (v.empty()) {
+    v.push_back(deg);
+  } else {
+    v.push_back(v.back() + diffDeg(deg, v.back()));
+  }
+}
+
+} // namespace
+
+double SampledSeries::at(double t) const {
+  int n = static_cast<int>(v.size());
+  if (n < 4) {
+    return v.empty() ? 0 : v[0];
+  }
+  double x = (t - t0) / step;
+  int j = std::min(n - 4, std::max(0, static_cast<int>(std::floor(x)) - 1));
+  double u = x - j;
+  // Lagrange weights for nodes u = 0, 1, 2, 3
+  double w0 = -(u - 1) * (u - 2) * (u - 3) / 6;
+  double w1 = u * (u - 2) * (u - 3) / 2;
+  double w2 = -u * (u - 1) * (u - 3) / 2;
+  double w3 = u * (u - 1) * (u - 2) / 6;
+  return w0 * v[j] + w1 * v[j + 1] + w2 * v[j + 2] + w3 * v[j + 3];
+}
+
+BodyTrack BodyTrack::build(int ipl, const std::string &star, double tjd_start, double tjd_end, int32 epheflag) {
+  BodyTrack track;
+  track.ipl = ipl;
+  track.star = star;
+  double step = !star.empty() ? 10 : (ipl == SE_MOON ? 0.25 : 1);
+  int32 iflag = (epheflag & (kEpheMask | SEFLG_NONUT | SEFLG_TRUEPOS)) | SEFLG_EQUATORIAL;
+  double t0 = tjd_start - 2 * step;
+  int n = static_cast<int>(std::ceil((tjd_end - tjd_start) / step)) + 5;
+  for (auto *s : {&track.ra, &track.dec, &track.dist}) {
+    s->t0 = t0;
+    s->step = step;
+    s->v.reserve(n);
+  }
+  char serr[AS_MAXCH];
+  char starname[SE_MAX_STNAME * 2 + 1];
+  for (int i = 0; i < n; i++) {
+    double xx[6];
+    int32 ret;
+    if (star.empty()) {
+      ret = ::swe_calc_ut(t0 + i * step, ipl, iflag, xx, serr);
+    } else {
+      std::strncpy(starname, star.c_str(), SE_MAX_STNAME);
+      starname[SE_MAX_STNAME] = '\0';
+      ret = ::swe_fixstar_ut(starname, t0 + i * step, iflag, xx, serr);
+    }
+    if (ret < 0) {
+      throw std::runtime_error(serr);
+    }
+    appendUnwrapped(track.ra.v, xx[0]);
+    track.dec.v.push_back(xx[1]);
+    track.dist.v.push_back(xx[2]);
+  }
+  if (star.empty()) {
+    if (ipl >= 0 && ipl < NDIAM) {
+      track.diameter = pla_diam[ipl];
+    } else if (ipl > SE_AST_OFFSET) {
+      track.diameter = swed.ast_diam * 1000; /* km -> m */
+    }
+  }
+  return track;
+}
+
+SiderealTrack SiderealTrack::build(double tjd_start, double tjd_end, double step) {
+  SiderealTrack track;
+  track.lst.t0 = tjd_start - 2 * step;
+  track.lst.step = step;
+  int n = static_cast<int>(std::ceil((tjd_end - tjd_start) / step)) + 5;
+  for (int i = 0; i < n; i++) {
+    appendUnwrapped(track.lst.v, ::swe_sidtime(track.lst.t0 + i * step) * 15);
+  }
+  return track;
+}
+
+Observer::Observer(const double *pos, double atpress, double attemp, int32 rsmi) {
+  for (int i = 0; i < 3; i++) {
+    geopos[i] = pos[i];
+  }
+  double lat = geopos[1] * DEGTORAD;
+  sinLat = std::sin(lat);
+  cosLat = std::cos(lat);
+  double u = std::atan((1 - EARTH_OBLATENESS) * std::tan(lat));
+  double h = geopos[2] / EARTH_RADIUS;
+  rhoCos = (std::cos(u) + h * cosLat) * EARTH_RADIUS / AUNIT;
+  rhoSin = ((1 - EARTH_OBLATENESS) * std::sin(u) + h * sinLat) * EARTH_RADIUS / AUNIT;
+  horizon = 0;
+  if (!(rsmi & SE_BIT_NO_REFRACTION)) {
+    if (atpress == 0) {
+      /* estimate atmospheric pressure, as swe_azalt() does */
+      atpress = 1013.25 * std::pow(1 - 0.0065 * geopos[2] / 288, 5.255);
+    }
+    // true altitude that refraction lifts to an apparent altitude of 0,
+    // with the refraction table of swe_azalt()
+    double lo = -5, hi = 0;
+    for (int i = 0; i < 50; i++) {
+      double mid = 0.5 * (lo + hi);
+      double app = ::swi_refrac_extended(mid, geopos[2], atpress, attemp, SE_LAPSE_RATE, SE_TRUE_TO_APP, NULL);
+      if (app < 0) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    horizon = hi;
+  }
+}
+
+TopoPosition topocentric(const BodyTrack &body, const SiderealTrack &sid, const Observer &obs, double t) {
+  double ra = body.ra.at(t) * DEGTORAD;
+  double dec = body.dec.at(t) * DEGTORAD;
+  double dist = body.dist.at(t);
+  double ha = (sid.lst.at(t) + obs.geopos[0]) * DEGTORAD - ra;
+  // geocentric vector in the hour angle frame, minus the observer
+  double x = dist * std::cos(dec) * std::cos(ha) - obs.rhoCos;
+  double y = dist * std::cos(dec) * std::sin(ha);
+  double z = dist * std::sin(dec) - obs.rhoSin;
+  TopoPosition p;
+  double rxy = std::sqrt(x * x + y * y);
+  p.hourAngle = diffDeg(std::atan2(y, x) * RADTODEG, 0);
+  p.dec = std::atan2(z, rxy) * RADTODEG;
+  p.dist = std::sqrt(rxy * rxy + z * z);
+  double sinAlt = obs.sinLat * z / p.dist + obs.cosLat * x / p.dist;
+  p.alt = std::asin(std::max(-1.0, std::min(1.0, sinAlt))) * RADTODEG;
+  return p;
+}
+
+double horizonOffset(const BodyTrack &body, const Observer &obs, int32 rsmi, const TopoPosition &p) {
+  double rdi = 0;
+  if (!(rsmi & SE_BIT_DISC_CENTER) && body.diameter > 0) {
+    double curdist = p.dist;
+    if (rsmi & SE_BIT_FIXED_DISC_SIZE) {
+      if (body.ipl == SE_SUN) {
+        curdist = 1.0;
+      } else if (body.ipl == SE_MOON) {
+        curdist = 0.00257;
+      }
+    }
+    rdi = std::asin(body.diameter / 2 / AUNIT / curdist) * RADTODEG;
+  }
+  double limb = (rsmi & SE_BIT_DISC_BOTTOM) ? p.alt - rdi : p.alt + rdi;
+  return limb - obs.horizon;
+}
+
+std::map<std::string, std::vector<double>> swe_rise_trans_calendar(double tjd_start, int ndays, const std::vector<double> &geopos,
+                                                                   const std::vector<int> &bodies, int epheflag, int rsmi,
+                                                                   double atpress, double attemp) {
+  if (geopos.size() % 3 != 0) {
+    throw std::runtime_error("geopos must hold longitude, latitude and height for each location.");
+  }
+  size_t nloc = geopos.size() / 3;
+  size_t nbody = bodies.size();
+  size_t cells = static_cast<size_t>(std::max(0, ndays)) * nloc * nbody;
+  std::map<std::string, std::vector<double>> result;
+  const char *keys[] = {"rise", "set", "mtransit", "itransit"};
+  std::vector<double> *out[4];
+  for (int k = 0; k < 4; k++) {
+    out[k] = &result[keys[k]];
+    out[k]->assign(cells, NAN);
+  }
+  if (cells == 0) {
+    return result;
+  }
+  for (size_t m = 0; m < nloc; m++) {
+    if (geopos[3 * m + 2] < SEI_ECL_GEOALT_MIN || geopos[3 * m + 2] > SEI_ECL_GEOALT_MAX) {
+      throw std::runtime_error("location height must be between -500 and 25000 m above sea.");
+    }
+  }
+  // day windows start at local mean midnight, up to half a day either side
+  // of tjd_start; body positions and sidereal time are computed once for
+  // the whole span and shared by all locations
+  double span0 = tjd_start - 1, span1 = tjd_start + ndays + 1;
+  std::vector<BodyTrack> tracks;
+  for (int ipl : bodies) {
+    tracks.push_back(BodyTrack::build(ipl, "", span0, span1, epheflag));
+  }
+  SiderealTrack sid = SiderealTrack::build(span0, span1, 0.25);
+
+  parallelFor(nloc, [&](size_t begin, size_t end, size_t) {
+    for (size_t m = begin; m < end; m++) {
+      Observer obs(&geopos[3 * m], atpress, attemp, rsmi);
+      double start = tjd_start - obs.geopos[0] / 360;
+      for (size_t b = 0; b < nbody; b++) {
+        findHorizonEvents(tracks[b], sid, obs, rsmi, start, start + ndays, [&](int event, double t) {
+          size_t d = static_cast<size_t>(std::floor(t - start));
+          size_t idx = (d * nloc + m) * nbody + b;
+          if (d < static_cast<size_t>(ndays) && std::isnan((*out[event])[idx])) {
+            (*out[event])[idx] = t;
+          }
+        });
+      }
+    }
+  });
+  return result;
+}
+
+std::map<std::string, std::vector<double>> swe_horizon_events(double tjd_start, double tjd_end, const std::vector<double> &geopos,
+                                                              const std::vector<int> &bodies, const std::vector<std::string> &stars,
+                                                              int epheflag, int rsmi, double atpress, double attemp) {
+  if (geopos.size() < 3) {
+    throw std::runtime_error("geopos must hold longitude, latitude and height.");
+  }
+  if (geopos[2] < SEI_ECL_GEOALT_MIN || geopos[2] > SEI_ECL_GEOALT_MAX) {
+    throw std::runtime_error("location height must be between -500 and 25000 m above sea.");
+  }
+  if (!(tjd_end > tjd_start)) {
+    throw std::runtime_error("tjd_end must be later than tjd_start.");
+  }
+  struct Event {
+    double tjd;
+    int event;
+    int object;
+  };
+  size_t nobj = bodies.size() + stars.size();
+  std::vector<std::vector<Event>> events(nobj);
+  SiderealTrack sid = SiderealTrack::build(tjd_start, tjd_end, 0.25);
+  Observer obs(geopos.data(), atpress, attemp, rsmi);
+  // objects are independent; all of them share the sidereal time samples
+  // and the observer geometry
+  parallelFor(nobj, [&](size_t begin, size_t end, size_t) {
+    for (size_t i = begin; i < end; i++) {
+      BodyTrack track = i < bodies.size()
+        ? BodyTrack::build(bodies[i], "", tjd_start, tjd_end, epheflag)
+        : BodyTrack::build(0, stars[i - bodies.size()], tjd_start, tjd_end, epheflag);
+      findHorizonEvents(track, sid, obs, rsmi, tjd_start, tjd_end, [&](int event, double t) {
+        events[i].push_back({t, event, static_cast<int>(i)});
+      });
+    }
+  });
+
+  std::vector<Event> merged;
+  for (auto &e : events) {
+    merged.insert(merged.end(), e.begin(), e.end());
+  }
+  std::stable_sort(merged.begin(), merged.end(), [](const Event &a, const Event &b) { return a.tjd < b.tjd; });
+  std::map<std::string, std::vector<double>> result;
+  auto &tjd = result["tjd"], &event = result["event"], &object = result["object"];
+  for (const auto &e : merged) {
+    tjd.push_back(e.tjd);
+    event.push_back(e.event);
+    object.push_back(e.object);
+  }
+  return result;
+}
+
+std::map<std::string, std::vector<double>> swe_twilight_table(double tjd_start, int ndays, const std::vector<double> &geopos, int epheflag) {
+  if (geopos.size() % 3 != 0) {
+    throw std::runtime_error("geopos must hold longitude, latitude and height for each location.");
+  }
+  size_t nloc = geopos.size() / 3;
+  size_t cells = static_cast<size_t>(std::max(0, ndays)) * nloc;
+  // begin = morning crossing upwards, end = evening crossing downwards
+  const std::vector<double> levels = {-6, -12, -18};
+  const char *beginKeys[] = {"civilBegin", "nauticalBegin", "astronomicalBegin"};
+  const char *endKeys[] = {"civilEnd", "nauticalEnd", "astronomicalEnd"};
+  std::map<std::string, std::vector<double>> result;
+  std::vector<double> *begins[3], *ends[3];
+  for (int k = 0; k < 3; k++) {
+    begins[k] = &result[beginKeys[k]];
+    ends[k] = &result[endKeys[k]];
+    begins[k]->assign(cells, NAN);
+    ends[k]->assign(cells, NAN);
+  }
+  if (cells == 0) {
+    return result;
+  }
+  double span0 = tjd_start - 1, span1 = tjd_start + ndays + 1;
+  BodyTrack sun = BodyTrack::build(SE_SUN, "", span0, span1, epheflag);
+  SiderealTrack sid = SiderealTrack::build(span0, span1, 0.25);
+
+  parallelFor(nloc, [&](size_t begin, size_t end, size_t) {
+    for (size_t m = begin; m < end; m++) {
+      // twilight ignores refraction, as swe_rise_trans() does for it
+      Observer obs(&geopos[3 * m], 0, 0, SE_BIT_NO_REFRACTION);
+      double start = tjd_start - obs.geopos[0] / 360;
+      findAltitudeCrossings(sun, sid, obs, levels, start, start + ndays, [&](int level, bool rising, double t) {
+        size_t d = static_cast<size_t>(std::floor(t - start));
+        size_t idx = d * nloc + m;
+        std::vector<double> &out = rising ? *begins[level] : *ends[level];
+        if (d < static_cast<size_t>(ndays) && std::isnan(out[idx])) {
+          out[idx] = t;
+        }
+      });
+    }
+  });
+  return result;
+}
+
+namespace {
+
+// Records whose days lie within this many days of the first one of a block
+// share the body and sidereal time samples of that block.
+constexpr double kGauquelinBlockDays = 32;
+
+struct GauquelinBlock {
+  size_t begin, end; /* range of the sorted records */
+  std::vector<BodyTrack> tracks;
+  SiderealTrack sid;
+};
+
+// Sector of tjd from the rises and sets found around it, chosen the way
+// swe_gauquelin_sector() chooses them: the next rise and set after tjd,
+// then the previous set (or rise) searched from 1.2 days before the next
+// one. NAN where swe_rise_trans() might decide otherwise, i.e. if an event
+// is missing from the 26 hours it searches.
+double gauquelinFromEvents(const std::vector<std::pair<double, int>> &events, double tjd) {
+  const std::pair<double, int> *rise = nullptr, *set = nullptr;
+  for (const auto &e : events) {
+    if (e.first > tjd && e.first <= tjd + 26.0 / 24) {
+      if (e.second == HORIZON_RISE && !rise) {
+        rise = &e;
+      } else if (e.second == HORIZON_SET && !set) {
+        set = &e;
+      }
+    }
+  }
+  if (!rise || !set) {
+    return NAN;
+  }
+  bool above = rise->first >= set->first;
+  const auto &next = above ? *rise : *set;
+  for (const auto &e : events) {
+    if (e.second == next.second && e.first > next.first - 1.2) {
+      if (e.first > tjd) {
+        // no event of this kind in the 1.2 days before the next one;
+        // rise_trans() may still find one or flag the body circumpolar
+        return NAN;
+      }
+      if (above) {
+        return (tjd - e.first) / (set->first - e.first) * 18 + 1;
+      }
+      return (tjd - e.first) / (rise->first - e.first) * 18 + 19;
+    }
+  }
+  return NAN;
+}
+
+} // namespace
+
+std::map<std::string, std::vector<double>> swe_gauquelin_sector_batch(const std::vector<double> &tjd_ut, const std::vector<double> &geopos,
+                                                                      const std::vector<int> &bodies, int iflag, int imeth,
+                                                                      double atpress, double attemp) {
+  if (geopos.size() % 3 != 0) {
+    throw std::runtime_error("geopos must hold longitude, latitude and height for each record.");
+  }
+  // a single location is used for every record
+  size_t n = tjd_ut.size();
+  size_t nloc = geopos.size() / 3;
+  if (nloc != n && nloc != 1) {
+    throw std::runtime_error("tjd_ut and geopos must describe the same number of records.");
+  }
+  if (imeth < 0 || imeth > 5) {
+    throw std::runtime_error("invalid method: " + std::to_string(imeth));
+  }
+  size_t nbody = bodies.size();
+  std::map<std::string, std::vector<double>> result;
+  auto &sector = result["sector"];
+  sector.assign(n * nbody, NAN);
+  if (n == 0 || nbody == 0) {
+    return result;
+  }
+  auto place = [&](size_t i) { return &geopos[3 * (nloc == 1 ? 0 : i)]; };
+  // NAN for a body without rise or set near the record, for which
+  // swe_gauquelin_sector() returns ERR and sets dgsect to 0; any other
+  // error is thrown, whatever the method.
+  auto scalar = [&](size_t i, size_t b) -> double {
+    double geo[3], dgsect = NAN;
+    char serr[AS_MAXCH] = "";
+    std::copy(place(i), place(i) + 3, geo);
+    if (::swe_gauquelin_sector(tjd_ut[i], bodies[b], NULL, iflag, imeth, geo, atpress, attemp, &dgsect, serr) < 0) {
+      if (dgsect == 0) {
+        return NAN;
+      }
+      throw std::runtime_error(serr);
+    }
+    return dgsect;
+  };
+  if (imeth < 2) {
+    // geometric methods, no searches to share
+    parallelFor(n, [&](size_t begin, size_t end, size_t) {
+      for (size_t i = begin; i < end; i++) {
+        for (size_t b = 0; b < nbody; b++) {
+          sector[i * nbody + b] = scalar(i, b);
+        }
+      }
+    });
+    return result;
+  }
+  for (size_t m = 0; m < nloc; m++) {
+    if (geopos[3 * m + 2] < SEI_ECL_GEOALT_MIN || geopos[3 * m + 2] > SEI_ECL_GEOALT_MAX) {
+      throw std::runtime_error("location height must be between -500 and 25000 m above sea.");
+    }
+  }
+  int32 rsmi = 0;
+  if (imeth == 2 || imeth == 4) {
+    rsmi |= SE_BIT_NO_REFRACTION;
+  }
+  if (imeth == 2 || imeth == 3) {
+    rsmi |= SE_BIT_DISC_CENTER;
+  }
+  int32 epheflag = iflag & kEpheMask;
+
+  // Records are ordered by day, then place, so that records of the same
+  // place and day follow each other and share one search for the rises and
+  // sets of each body. Blocks of neighbouring days share the body positions
+  // and sidereal time, computed once per block.
+  std::vector<size_t> order(n);
+  for (size_t i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    double da = std::floor(tjd_ut[a]), db = std::floor(tjd_ut[b]);
+    if (da != db) {
+      return da < db;
+    }
+    const double *pa = place(a), *pb = place(b);
+    if (!std::equal(pa, pa + 3, pb)) {
+      return std::lexicographical_compare(pa, pa + 3, pb, pb + 3);
+    }
+    return tjd_ut[a] < tjd_ut[b];
+  });
+  std::vector<GauquelinBlock> blocks;
+  std::vector<size_t> blockOf(n);
+  for (size_t k = 0; k < n; k++) {
+    if (blocks.empty() || std::floor(tjd_ut[order[k]]) - std::floor(tjd_ut[order[blocks.back().begin]]) >= kGauquelinBlockDays) {
+      blocks.push_back({k, k, {}, {}});
+    }
+    blocks.back().end = k + 1;
+    blockOf[k] = blocks.size() - 1;
+  }
+  // events are searched from 1.5 days before to 2.5 days after the day of
+  // the record
+  parallelFor(blocks.size(), [&](size_t begin, size_t end, size_t) {
+    for (size_t j = begin; j < end; j++) {
+      GauquelinBlock &blk = blocks[j];
+      double span0 = std::floor(tjd_ut[order[blk.begin]]) - 1.5;
+      double span1 = std::floor(tjd_ut[order[blk.end - 1]]) + 2.5;
+      for (int ipl : bodies) {
+        blk.tracks.push_back(BodyTrack::build(ipl, "", span0, span1, epheflag));
+      }
+      blk.sid = SiderealTrack::build(span0, span1, 0.25);
+    }
+  });
+
+  parallelFor(n, [&](size_t begin, size_t end, size_t) {
+    std::vector<std::vector<std::pair<double, int>>> events(nbody);
+    std::unique_ptr<Observer> obs;
+    double day = NAN;
+    for (size_t k = begin; k < end; k++) {
+      size_t i = order[k];
+      const GauquelinBlock &blk = blocks[blockOf[k]];
+      bool samePlace = obs && std::equal(obs->geopos, obs->geopos + 3, place(i));
+      if (!samePlace) {
+        obs.reset(new Observer(place(i), atpress, attemp, rsmi));
+      }
+      bool search = !samePlace || std::floor(tjd_ut[i]) != day;
+      day = std::floor(tjd_ut[i]);
+      for (size_t b = 0; b < nbody; b++) {
+        if (search) {
+          events[b].clear();
+          findHorizonEvents(blk.tracks[b], blk.sid, *obs, rsmi, day - 1.5, day + 2.5, [&](int event, double t) {
+            if (event == HORIZON_RISE || event == HORIZON_SET) {
+              events[b].push_back({t, event});
+            }
+          });
+        }
+        double dgsect = gauquelinFromEvents(events[b], tjd_ut[i]);
+        if (std::isnan(dgsect)) {
+          // circumpolar near the record, or events beyond the searched
+          // days: leave it to swe_rise_trans()
+          dgsect = scalar(i, b);
+        }
+        sector[i * nbody + b] = dgsect;
+      }
+    }
+  });
+  return result;
+}
+
+} // namespace swisseph
@@ -0,0 +1,215 @@
+#ifndef SWISSEPH_HORIZON_H
+#define SWISSEPH_HORIZON_H
+#include "RNSwissephBatch.h"
+
+namespace swisseph {
+
+// Event codes reported by the horizon searches.
+enum HorizonEvent {
+  HORIZON_RISE = 0,
+  HORIZON_SET = 1,
+  HORIZON_MTRANSIT = 2,
+  HORIZON_ITRANSIT = 3,
+};
+
+// Samples on a uniform time grid, interpolated with 4-point Lagrange
+// polynomials. Angles must be stored unwrapped.
+struct SampledSeries {
+  double t0 = 0;
+  double step = 1;
+  std::vector<double> v;
+
+  double at(double t) const;
+};
+
+// Geocentric apparent equatorial position of one body (or fixed star) over a
+// time span. Computed once and shared by every observer.
+struct BodyTrack {
+  int ipl = 0;
+  std::string star;
+  double diameter = 0; /* m, 0 for stars */
+  SampledSeries ra, dec, dist;
+
+  static BodyTrack build(int ipl, const std::string &star, double tjd_start, double tjd_end, int32 epheflag);
+};
+
+// Local apparent sidereal time in degrees at longitude 0, unwrapped.
+struct SiderealTrack {
+  SampledSeries lst;
+
+  static SiderealTrack build(double tjd_start, double tjd_end, double step);
+};
+
+// Observer-dependent horizon geometry.
+struct Observer {
+  double geopos[3];
+  double sinLat, cosLat;
+  double rhoCos, rhoSin; /* geocentric observer position in AU */
+  double horizon;        /* true altitude of the apparent horizon */
+
+  Observer(const double *geopos, double atpress, double attemp, int32 rsmi);
+};
+
+struct TopoPosition {
+  double hourAngle; /* degrees, [-180, 180) */
+  double dec;
+  double dist;
+  double alt;       /* true altitude of the center */
+};
+
+TopoPosition topocentric(const BodyTrack &body, const SiderealTrack &sid, const Observer &obs, double t);
+
+// Altitude of the limb selected by rsmi above the observer's horizon.
+double horizonOffset(const BodyTrack &body, const Observer &obs, int32 rsmi, const TopoPosition &p);
+
+// Finds rise, set and meridian transits of `body` in [tjd_start, tjd_end)
+// for one observer. rsmi takes the SE_BIT_DISC_CENTER, SE_BIT_DISC_BOTTOM,
+// SE_BIT_NO_REFRACTION and SE_BIT_FIXED_DISC_SIZE bits of swe_rise_trans().
+// Events are passed to emit(event, tjd) in time order.
+template <typename Emit>
+void findHorizonEvents(const BodyTrack &body, const SiderealTrack &sid, const Observer &obs, int32 rsmi,
+                       double tjd_start, double tjd_end, Emit emit) {
+  // hourly samples; a culmination between samples that reaches across the
+  // horizon is caught by the extremum check below
+  const double step = 1.0 / 24;
+  int n = std::max(1, static_cast<int>(std::ceil((tjd_end - tjd_start) / step)));
+  auto alt = [&](double t) { return horizonOffset(body, obs, rsmi, topocentric(body, sid, obs, t)); };
+  auto upper = [&](double t) { return topocentric(body, sid, obs, t).hourAngle; };
+  auto lower = [&](double t) { return diffDeg(topocentric(body, sid, obs, t).hourAngle, 180); };
+  struct Found {
+    double t;
+    int event;
+  };
+  std::vector<Found> found;
+  std::vector<double> ts(n + 1), h(n + 1), hu(n + 1), hl(n + 1);
+  for (int i = 0; i <= n; i++) {
+    ts[i] = std::min(tjd_end, tjd_start + i * step);
+    TopoPosition p = topocentric(body, sid, obs, ts[i]);
+    h[i] = horizonOffset(body, obs, rsmi, p);
+    hu[i] = p.hourAngle;
+    hl[i] = diffDeg(p.hourAngle, 180);
+  }
+  auto addCrossing = [&](double ta, double fa, double tb, double fb) {
+    double t = findRoot(alt, ta, fa, tb, fb, 1e-6);
+    if (t >= tjd_start && t < tjd_end) {
+      found.push_back({t, fa < 0 ? HORIZON_RISE : HORIZON_SET});
+    }
+  };
+  for (int i = 1; i <= n; i++) {
+    if ((h[i - 1] < 0) != (h[i] < 0)) {
+      addCrossing(ts[i - 1], h[i - 1], ts[i], h[i]);
+    } else if (i < n && (h[i] < 0) == (h[i + 1] < 0)) {
+      // local extremum pointing towards the horizon
+      bool max = h[i] > h[i - 1] && h[i] > h[i + 1] && h[i] < 0;
+      bool min = h[i] < h[i - 1] && h[i] < h[i + 1] && h[i] > 0;
+      if (max || min) {
+        double a = ts[i - 1], b = ts[i + 1];
+        for (int k = 0; k < 40; k++) {
+          double m1 = a + (b - a) * 0.382, m2 = a + (b - a) * 0.618;
+          if ((alt(m1) > alt(m2)) == max) {
+            b = m2;
+          } else {
+            a = m1;
+          }
+        }
+        double te = 0.5 * (a + b), he = alt(te);
+        if ((he < 0) != (h[i] < 0)) {
+          addCrossing(ts[i - 1], h[i - 1], te, he);
+          addCrossing(te, he, ts[i + 1], h[i + 1]);
+        }
+      }
+    }
+    // hour angle increases with time; a jump across +-180 is not a transit
+    if (hu[i - 1] < 0 && hu[i] >= 0 && hu[i] - hu[i - 1] < 180) {
+      double t = findRoot(upper, ts[i - 1], hu[i - 1], ts[i], hu[i], 1e-6);
+      if (t >= tjd_start && t < tjd_end) {
+        found.push_back({t, HORIZON_MTRANSIT});
+      }
+    }
+    if (hl[i - 1] < 0 && hl[i] >= 0 && hl[i] - hl[i - 1] < 180) {
+      double t = findRoot(lower, ts[i - 1], hl[i - 1], ts[i], hl[i], 1e-6);
+      if (t >= tjd_start && t < tjd_end) {
+        found.push_back({t, HORIZON_ITRANSIT});
+      }
+    }
+  }
+  std::sort(found.begin(), found.end(), [](const Found &a, const Found &b) { return a.t < b.t; });
+  for (const auto &f : found) {
+    emit(f.event, f.t);
+  }
+}
+
+// Finds the times in [tjd_start, tjd_end) at which the true altitude of the
+// center of `body` crosses each of `levels` (degrees). All levels are found
+// from one set of hourly samples; emit(level, rising, tjd) is called in time
+// order.
+template <typename Emit>
+void findAltitudeCrossings(const BodyTrack &body, const SiderealTrack &sid, const Observer &obs,
+                           const std::vector<double> &levels, double tjd_start, double tjd_end, Emit emit) {
+  const double step = 1.0 / 24;
+  int n = std::max(1, static_cast<int>(std::ceil((tjd_end - tjd_start) / step)));
+  auto alt = [&](double t) { return topocentric(body, sid, obs, t).alt; };
+  struct Found {
+    double t;
+    int level;
+    bool rising;
+  };
+  std::vector<Found> found;
+  std::vector<double> ts(n + 1), h(n + 1);
+  for (int i = 0; i <= n; i++) {
+    ts[i] = std::min(tjd_end, tjd_start + i * step);
+    h[i] = alt(ts[i]);
+  }
+  auto addCrossing = [&](int level, double ta, double fa, double tb, double fb) {
+    double t = findRoot([&](double x) { return alt(x) - levels[level]; }, ta, fa, tb, fb, 1e-6);
+    if (t >= tjd_start && t < tjd_end) {
+      found.push_back({t, level, fb > fa});
+    }
+  };
+  for (int i = 1; i <= n; i++) {
+    // extremum of the curve inside [t(i-1), t(i+1)], located at most once
+    bool extremum = i < n && ((h[i] > h[i - 1] && h[i] > h[i + 1]) || (h[i] < h[i - 1] && h[i] < h[i + 1]));
+    double te = 0, he = 0;
+    bool located = false;
+    for (int l = 0; l < static_cast<int>(levels.size()); l++) {
+      double fa = h[i - 1] - levels[l], fb = h[i] - levels[l];
+      if ((fa < 0) != (fb < 0)) {
+        addCrossing(l, ts[i - 1], fa, ts[i], fb);
+        continue;
+      }
+      double fc = extremum ? h[i + 1] - levels[l] : 0;
+      if (!extremum || (fb < 0) != (fc < 0) || ((h[i] > h[i - 1]) != (fb < 0))) {
+        continue;
+      }
+      // a culmination pointing towards this level may cross it in between
+      if (!located) {
+        bool max = h[i] > h[i - 1];
+        double a = ts[i - 1], b = ts[i + 1];
+        for (int k = 0; k < 40; k++) {
+          double m1 = a + (b - a) * 0.382, m2 = a + (b - a) * 0.618;
+          if ((alt(m1) > alt(m2)) == max) {
+            b = m2;
+          } else {
+            a = m1;
+          }
+        }
+        te = 0.5 * (a + b);
+        he = alt(te);
+        located = true;
+      }
+      double fe = he - levels[l];
+      if ((fe < 0) != (fb < 0)) {
+        addCrossing(l, ts[i - 1], fa, te, fe);
+        addCrossing(l, te, fe, ts[i + 1], fc);
+      }
+    }
+  }
+  std::sort(found.begin(), found.end(), [](const Found &a, const Found &b) { return a.t < b.t; });
+  for (const auto &f : found) {
+    emit(f.level, f.rising, f.t);
+  }
+}
+
+} // namespace swisseph
+
+#endif /* SWISSEPH_HORIZON_H */
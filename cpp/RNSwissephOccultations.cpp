@@ -0,0 +1,275 @@
+#include "RNSwissephStars.h"
+#include <cstring>
+#include <memory>
+#include <set>
+
+namespace swisseph {
+
+namespace {
+
+// Step of the sweep along the Moon's path; the Moon moves less than 4.2
+// degrees in that time.
+constexpr double kSweepStep = 0.25;
+// Stars are held at their position in the middle of each window of this
+// length; precession, aberration and nutation move them by less than
+// 0.05 degrees within it.
+constexpr double kStarWindow = 365.25;
+// Greatest geocentric distance between the Moon's center and a target at
+// which an occultation can be seen somewhere on Earth: lunar parallax and
+// radius at perigee, plus a margin for the straight line interpolation of
+// the Moon's path and for the fixed star positions.
+constexpr double kReach = 1.03 + 0.28 + 0.2;
+// Cells of the star index in degrees.
+constexpr double kCellSize = 5;
+constexpr int kRaCells = 72;
+// The Moon never goes beyond 29 degrees of declination.
+constexpr double kMaxDec = 29 + kReach;
+constexpr int kDecCells = 13; /* covers [-32.5, 32.5) */
+
+struct Target {
+  std::string name;
+  std::string star; /* key for swe_fixstar(), empty for bodies */
+  int ipl;
+};
+
+struct Equatorial {
+  double ra, dec;
+};
+
+Equatorial targetPosition(const Target &target, double tjd_ut, int iflag) {
+  double xx[6];
+  char serr[AS_MAXCH];
+  int32 ret;
+  if (target.star.empty()) {
+    ret = ::swe_calc_ut(tjd_ut, target.ipl, iflag | SEFLG_EQUATORIAL, xx, serr);
+  } else {
+    char star[SE_MAX_STNAME * 2 + 1];
+    std::strncpy(star, target.star.c_str(), SE_MAX_STNAME);
+    star[SE_MAX_STNAME] = '\0';
+    ret = ::swe_fixstar_ut(star, tjd_ut, iflag | SEFLG_EQUATORIAL, xx, serr);
+  }
+  if (ret < 0) {
+    throw std::runtime_error(serr);
+  }
+  return {xx[0], xx[1]};
+}
+
+// Smallest distance in degrees, and the fraction of the segment at which it
+// occurs, between a target and the Moon moving in a straight line from `a`
+// to `b` while the target moves from `ta` to `tb`. Flat geometry around the
+// target is good enough at the distances that matter.
+double closestApproach(const Equatorial &a, const Equatorial &b, const Equatorial &ta, const Equatorial &tb, double *frac) {
+  double c = std::cos(ta.dec * DEGTORAD);
+  double x0 = diffDeg(a.ra, ta.ra) * c, y0 = a.dec - ta.dec;
+  double x1 = diffDeg(b.ra, tb.ra) * c, y1 = b.dec - tb.dec;
+  double dx = x1 - x0, dy = y1 - y0;
+  double len2 = dx * dx + dy * dy;
+  double u = len2 > 0 ? std::max(0.0, std::min(1.0, -(x0 * dx + y0 * dy) / len2)) : 0;
+  *frac = u;
+  return std::hypot(x0 + u * dx, y0 + u * dy);
+}
+
+// Star positions for one window of the sweep, bucketed by right ascension
+// and declination.
+struct StarIndex {
+  std::vector<Equatorial> pos;
+  std::vector<std::vector<int>> cells;
+
+  StarIndex(const std::vector<Target> &targets, const std::vector<int> &stars, double tjd_ut, int iflag)
+      : pos(targets.size()), cells(kRaCells * kDecCells) {
+    for (int i : stars) {
+      pos[i] = targetPosition(targets[i], tjd_ut, iflag);
+      if (std::fabs(pos[i].dec) < kMaxDec) {
+        cells[cell(pos[i].ra, pos[i].dec)].push_back(i);
+      }
+    }
+  }
+
+  static int raCell(double ra) {
+    return static_cast<int>(std::floor(::swe_degnorm(ra) / kCellSize)) % kRaCells;
+  }
+
+  static int decCell(double dec) {
+    return std::max(0, std::min(kDecCells - 1, static_cast<int>(std::floor(dec / kCellSize + kDecCells / 2.0))));
+  }
+
+  static int cell(double ra, double dec) {
+    return decCell(dec) * kRaCells + raCell(ra);
+  }
+
+  // Calls fn(target) for every star within kReach of the Moon's path from
+  // `a` to `b`, and for a few more.
+  template <typename Fn>
+  void near(const Equatorial &a, const Equatorial &b, Fn fn) const {
+    double dec0 = std::min(a.dec, b.dec) - kReach, dec1 = std::max(a.dec, b.dec) + kReach;
+    double widen = kReach / std::cos(std::min(89.0, std::max(std::fabs(dec0), std::fabs(dec1))) * DEGTORAD);
+    double ra0 = a.ra, ra1 = a.ra + diffDeg(b.ra, a.ra);
+    if (ra1 < ra0) {
+      std::swap(ra0, ra1);
+    }
+    int nra = std::min(kRaCells, static_cast<int>(std::floor((ra1 + widen) / kCellSize) - std::floor((ra0 - widen) / kCellSize)) + 1);
+    int r0 = raCell(ra0 - widen);
+    for (int d = decCell(dec0); d <= decCell(dec1); d++) {
+      for (int k = 0; k < nra; k++) {
+        for (int i : cells[d * kRaCells + (r0 + k) % kRaCells]) {
+          fn(i);
+        }
+      }
+    }
+  }
+};
+
+struct Occultation {
+  double tret[10];
+  int32 type;
+  int target;
+};
+
+// Adds the catalog stars not fainter than maglimit.
+void addCatalogStars(double maglimit, std::vector<Target> &targets, std::set<std::string> &seen) {
+  if (maglimit < kBrightestStar) {
+    return;
+  }
+  for (const auto &entry : readStarCatalog()) {
+    if (entry.magnitude <= maglimit && seen.insert(entry.name).second) {
+      targets.push_back({entry.name, entry.name, -1});
+    }
+  }
+}
+
+} // namespace
+
+// All lunar occultations of `bodies`, `stars` and the catalog stars not
+// fainter than `maglimit` (e.g. -99 for none) with maximum in
+// [tjd_start, tjd_end). One sweep along the Moon's path collects conjunctions
+// close enough to be an occultation somewhere on Earth; each one is then
+// confirmed with swe_lun_occult_when_glob(), whose tret[] is returned.
+// Without a star catalog, only named `stars` are an error.
+OccultationScan swe_lun_occult_scan(double tjd_start, double tjd_end, const std::vector<int> &bodies,
+                                    const std::vector<std::string> &stars, double maglimit, int iflag) {
+  if (!(tjd_end > tjd_start)) {
+    throw std::runtime_error("tjd_end must be later than tjd_start.");
+  }
+  iflag &= SEFLG_JPLEPH | SEFLG_SWIEPH | SEFLG_MOSEPH;
+  std::vector<Target> targets;
+  std::set<std::string> seen;
+  for (int ipl : bodies) {
+    if (ipl == SE_SUN || ipl == SE_MOON || ipl == SE_EARTH) {
+      throw std::runtime_error("bodies must not include the Sun, the Moon or the Earth.");
+    }
+    char name[AS_MAXCH];
+    ::swe_get_planet_name(ipl, name);
+    targets.push_back({name, "", ipl});
+  }
+  for (const auto &s : stars) {
+    // swe_fixstar_mag() resolves the name to the full catalog name
+    char star[SE_MAX_STNAME * 2 + 1], serr[AS_MAXCH];
+    double mag;
+    std::strncpy(star, s.c_str(), SE_MAX_STNAME);
+    star[SE_MAX_STNAME] = '\0';
+    if (::swe_fixstar_mag(star, &mag, serr) < 0) {
+      throw std::runtime_error(serr);
+    }
+    if (seen.insert(star).second) {
+      targets.push_back({star, star, -1});
+    }
+  }
+  addCatalogStars(maglimit, targets, seen);
+  std::vector<int> planetTargets, starTargets;
+  for (size_t i = 0; i < targets.size(); i++) {
+    (targets[i].star.empty() ? planetTargets : starTargets).push_back(static_cast<int>(i));
+  }
+
+  // slices of at least a month, a few per worker for load balancing
+  size_t workers = workerCount(static_cast<size_t>((tjd_end - tjd_start) / 30) + 1);
+  size_t nslices = workers * 4;
+  double span = (tjd_end - tjd_start) / nslices;
+  std::vector<std::vector<Occultation>> found(nslices);
+  parallelFor(nslices, workers, [&](size_t begin, size_t end, size_t) {
+    for (size_t s = begin; s < end; s++) {
+      double ts = tjd_start + s * span;
+      double te = (s + 1 == nslices) ? tjd_end : ts + span;
+      std::unique_ptr<StarIndex> index;
+      int window = -1;
+      std::vector<double> last(targets.size(), -1e10);
+      std::vector<Equatorial> pa(targets.size()), pb(targets.size());
+      Target moon = {"", "", SE_MOON};
+      Equatorial ma = targetPosition(moon, ts, iflag);
+      for (int i : planetTargets) {
+        pa[i] = targetPosition(targets[i], ts, iflag);
+      }
+      for (double ta = ts; ta < te; ta += kSweepStep) {
+        double tb = std::min(te, ta + kSweepStep);
+        Equatorial mb = targetPosition(moon, tb, iflag);
+        for (int i : planetTargets) {
+          pb[i] = targetPosition(targets[i], tb, iflag);
+        }
+        int w = static_cast<int>(std::floor((ta - tjd_start) / kStarWindow));
+        if (w != window && !starTargets.empty()) {
+          index.reset(new StarIndex(targets, starTargets, tjd_start + (w + 0.5) * kStarWindow, iflag));
+          window = w;
+        }
+        auto check = [&](int i, const Equatorial &a, const Equatorial &b) {
+          double frac;
+          if (closestApproach(ma, mb, a, b, &frac) > kReach) {
+            return;
+          }
+          double tc = ta + frac * (tb - ta);
+          // the same conjunction seen from the next segment
+          if (tc - last[i] < 2) {
+            return;
+          }
+          last[i] = tc;
+          Occultation occ;
+          char star[SE_MAX_STNAME * 2 + 1], serr[AS_MAXCH] = "";
+          std::strncpy(star, targets[i].star.c_str(), SE_MAX_STNAME);
+          star[SE_MAX_STNAME] = '\0';
+          int ipl = targets[i].star.empty() ? targets[i].ipl : 0;
+          // examine this conjunction only
+          occ.type = ::swe_lun_occult_when_glob(tc - 1, ipl, star, iflag, 0, occ.tret, SE_ECL_ONE_TRY, serr);
+          if (occ.type < 0) {
+            if (std::strstr(serr, "never occurs") != NULL) {
+              return; /* star too far from the ecliptic */
+            }
+            throw std::runtime_error(serr);
+          }
+          if (occ.type > 0 && occ.tret[0] >= ts && occ.tret[0] < te) {
+            occ.target = i;
+            found[s].push_back(occ);
+          }
+        };
+        for (int i : planetTargets) {
+          check(i, pa[i], pb[i]);
+        }
+        if (index) {
+          index->near(ma, mb, [&](int i) { check(i, index->pos[i], index->pos[i]); });
+        }
+        ma = mb;
+        std::swap(pa, pb);
+      }
+    }
+  });
+
+  std::vector<Occultation> merged;
+  for (auto &slice : found) {
+    merged.insert(merged.end(), slice.begin(), slice.end());
+  }
+  std::stable_sort(merged.begin(), merged.end(), [](const Occultation &a, const Occultation &b) {
+    return a.tret[0] < b.tret[0];
+  });
+  OccultationScan result;
+  for (const auto &t : targets) {
+    result.targets.push_back(t.name);
+  }
+  auto &tjd = result.events["tjd"], &type = result.events["type"];
+  auto &target = result.events["target"], &tret = result.events["tret"];
+  for (const auto &o : merged) {
+    tjd.push_back(o.tret[0]);
+    type.push_back(o.type);
+    target.push_back(o.target);
+    tret.insert(tret.end(), o.tret, o.tret + 10);
+  }
+  return result;
+}
+
+} // namespace swisseph
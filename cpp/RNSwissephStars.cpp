@@ -0,0 +1,48 @@
+#include "RNSwissephStars.h"
+extern "C" {
+  #include "swephlib.h"
+}
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace swisseph {
+
+std::vector<CatalogEntry> readStarCatalog() {
+  std::vector<CatalogEntry> entries;
+  char serr[AS_MAXCH];
+  FILE *fp = ::swi_fopen(-1, const_cast<char *>(SE_STARFILE), swed.ephepath, serr);
+  if (fp == NULL) {
+    fp = ::swi_fopen(-1, const_cast<char *>(SE_STARFILE_OLD), swed.ephepath, serr);
+  }
+  if (fp == NULL) {
+    return entries;
+  }
+  char s[AS_MAXCH], *cpos[20];
+  while (std::fgets(s, AS_MAXCH, fp) != NULL) {
+    if (*s == '#' || std::strchr(s, ',') == NULL) {
+      continue;
+    }
+    // incomplete entries have no magnitude
+    int n = ::swi_cutstr(s, const_cast<char *>(","), cpos, 20);
+    double mag = n < 14 ? std::numeric_limits<double>::quiet_NaN() : std::atof(cpos[13]);
+    ::swi_right_trim(cpos[0]);
+    ::swi_right_trim(cpos[1]);
+    if (std::strlen(cpos[0]) > SE_MAX_STNAME) {
+      cpos[0][SE_MAX_STNAME] = '\0';
+    }
+    if (std::strlen(cpos[1]) > SE_MAX_STNAME - 1) {
+      cpos[1][SE_MAX_STNAME - 1] = '\0';
+    }
+    std::string name = cpos[0];
+    if (std::strlen(cpos[0]) + std::strlen(cpos[1]) + 1 < SE_MAX_STNAME - 1) {
+      name += std::string(",") + cpos[1];
+    }
+    entries.push_back({name, mag});
+  }
+  std::fclose(fp);
+  return entries;
+}
+
+} // namespace swisseph
@@ -0,0 +1,22 @@
+#ifndef SWISSEPH_STARS_H
+#define SWISSEPH_STARS_H
+#include "RNSwissephBatch.h"
+
+namespace swisseph {
+
+// Sirius, at -1.46, is the brightest star of the catalog; a limit brighter
+// than this one can match no star.
+constexpr double kBrightestStar = -1.5;
+
+struct CatalogEntry {
+  std::string name;  /* as swe_fixstar_mag() returns it, e.g. "Aldebaran,alTau" */
+  double magnitude;  /* NaN for incomplete entries */
+};
+
+// Entries of the star catalog (sefstars.txt, or fixstars.cat) in file order,
+// from a single pass over the file. A missing catalog means no entries.
+std::vector<CatalogEntry> readStarCatalog();
+
+} // namespace swisseph
+
+#endif /* SWISSEPH_STARS_H */
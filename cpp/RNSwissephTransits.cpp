@@ -0,0 +1,242 @@
+#include "RNSwissephBatch.h"
+
+namespace swisseph {
+
+namespace {
+
+// Upper bound of the geocentric longitude speed in degrees/day, used to pick
+// a sampling step that cannot jump over an orb window.
+double maxSpeed(int ipl) {
+  switch (ipl) {
+    case SE_MOON: return 15.5;
+    case SE_SUN: return 1.02;
+    case SE_MERCURY: return 2.3;
+    case SE_VENUS: return 1.3;
+    case SE_MARS: return 0.8;
+    case SE_JUPITER: return 0.25;
+    case SE_SATURN: return 0.14;
+    case SE_URANUS:
+    case SE_NEPTUNE:
+    case SE_PLUTO: return 0.07;
+    case SE_MEAN_NODE:
+    case SE_TRUE_NODE: return 0.3;
+    case SE_MEAN_APOG:
+    case SE_OSCU_APOG: return 6.5;
+    default: return 1;
+  }
+}
+
+struct AspectTarget {
+  double offset;
+  int aspect;
+  double orb;
+};
+
+struct TransitEvent {
+  double tjd;
+  double longitude;
+  int type;
+  int body;
+  int natal;
+  int aspect;
+};
+
+double calcLongitude(double tjd_ut, int ipl, int iflag) {
+  double xx[6];
+  char serr[AS_MAXCH];
+  if (::swe_calc_ut(tjd_ut, ipl, iflag, xx, serr) < 0) {
+    throw std::runtime_error(serr);
+  }
+  return xx[0];
+}
+
+void scanSlice(double ts, double te, const std::vector<double> &natal, const std::vector<int> &bodies,
+               const std::vector<AspectTarget> &targets, int iflag, std::vector<TransitEvent> &out) {
+  size_t ncomb = natal.size() * targets.size();
+  std::vector<double> fprev(ncomb), fcur(ncomb);
+  for (int ipl : bodies) {
+    double minOrb = 360;
+    for (const auto &tg : targets) {
+      minOrb = std::min(minOrb, tg.orb);
+    }
+    double step = std::min(5.0, std::max(minOrb, 0.1) / maxSpeed(ipl) / 2);
+    auto offsetAt = [&](double tjd, size_t comb) {
+      const AspectTarget &tg = targets[comb % targets.size()];
+      return diffDeg(calcLongitude(tjd, ipl, iflag), natal[comb / targets.size()] + tg.offset);
+    };
+    double ta = ts;
+    double lon = calcLongitude(ta, ipl, iflag);
+    for (size_t c = 0; c < ncomb; c++) {
+      fprev[c] = diffDeg(lon, natal[c / targets.size()] + targets[c % targets.size()].offset);
+    }
+    while (ta < te) {
+      double tb = std::min(te, ta + step);
+      lon = calcLongitude(tb, ipl, iflag);
+      for (size_t c = 0; c < ncomb; c++) {
+        const AspectTarget &tg = targets[c % targets.size()];
+        int in = static_cast<int>(c / targets.size());
+        double fa = fprev[c];
+        double fb = diffDeg(lon, natal[in] + tg.offset);
+        fcur[c] = fb;
+        // exact hit; a jump across +-180 is the far side of the circle
+        if ((fa < 0) != (fb < 0) && std::fabs(fb - fa) < 180) {
+          double t = findRoot([&](double x) { return offsetAt(x, c); }, ta, fa, tb, fb);
+          out.push_back({t, calcLongitude(t, ipl, iflag), 1, ipl, in, tg.aspect});
+        }
+        // orb entry (|f| drops below orb) and exit
+        double ga = std::fabs(fa) - tg.orb;
+        double gb = std::fabs(fb) - tg.orb;
+        if ((ga < 0) != (gb < 0)) {
+          double t = findRoot([&](double x) { return std::fabs(offsetAt(x, c)) - tg.orb; }, ta, ga, tb, gb);
+          out.push_back({t, calcLongitude(t, ipl, iflag), gb < 0 ? 0 : 2, ipl, in, tg.aspect});
+        }
+      }
+      std::swap(fprev, fcur);
+      ta = tb;
+    }
+  }
+}
+
+// Mean synodic month in days.
+constexpr double kSynodicMonth = 29.530588853;
+
+struct Lunation {
+  double tjd;
+  double phase;
+  double sun;
+  double moon;
+};
+
+// Moon - Sun elongation minus `phase` in [-180, 180) and its rate in deg/day.
+double elongationOffset(double tjd_ut, double phase, int iflag, double *rate, double *sun, double *moon) {
+  double xs[6], xm[6];
+  char serr[AS_MAXCH];
+  if (::swe_calc_ut(tjd_ut, SE_SUN, iflag, xs, serr) < 0 || ::swe_calc_ut(tjd_ut, SE_MOON, iflag, xm, serr) < 0) {
+    throw std::runtime_error(serr);
+  }
+  *rate = xm[3] - xs[3];
+  *sun = xs[0];
+  *moon = xm[0];
+  return diffDeg(xm[0] - xs[0], phase);
+}
+
+// Newton iteration on the elongation, starting from an estimate that the mean
+// synodic rate already puts within a few hours of the event.
+Lunation refineLunation(double tjd_est, double phase, int iflag) {
+  Lunation l = {tjd_est, phase, 0, 0};
+  for (int i = 0; i < 20; i++) {
+    double rate;
+    double f = elongationOffset(l.tjd, phase, iflag, &rate, &l.sun, &l.moon);
+    double dt = -f / rate;
+    l.tjd += dt;
+    if (std::fabs(dt) < 1e-7) {
+      break;
+    }
+  }
+  return l;
+}
+
+} // namespace
+
+std::map<std::string, std::vector<double>> swe_lunations(double tjd_start, double tjd_end, const std::vector<double> &phases, int iflag) {
+  if (!(tjd_end > tjd_start)) {
+    throw std::runtime_error("tjd_end must be later than tjd_start.");
+  }
+  std::vector<double> targets;
+  for (double p : phases) {
+    targets.push_back(::swe_degnorm(p));
+  }
+  if (targets.empty()) {
+    targets = {0, 90, 180, 270};
+  }
+  std::sort(targets.begin(), targets.end());
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+  iflag = (iflag | SEFLG_SPEED) & ~(SEFLG_EQUATORIAL | SEFLG_XYZ | SEFLG_RADIANS);
+
+  double rate, sun, moon;
+  double elong = ::swe_degnorm(elongationOffset(tjd_start, 0, iflag, &rate, &sun, &moon));
+  size_t k = std::upper_bound(targets.begin(), targets.end(), elong) - targets.begin();
+  double t = tjd_start;
+  std::map<std::string, std::vector<double>> result;
+  auto &tjd = result["tjd"], &phase = result["phase"];
+  auto &sunLongitude = result["sunLongitude"], &moonLongitude = result["moonLongitude"];
+  for (;;) {
+    double target = targets[k % targets.size()];
+    double gap = ::swe_degnorm(target - elong);
+    if (gap == 0) {
+      gap = 360;
+    }
+    Lunation l = refineLunation(t + gap / 360.0 * kSynodicMonth, target, iflag);
+    if (l.tjd >= tjd_end) {
+      break;
+    }
+    if (l.tjd >= tjd_start) {
+      tjd.push_back(l.tjd);
+      phase.push_back(l.phase);
+      sunLongitude.push_back(l.sun);
+      moonLongitude.push_back(l.moon);
+    }
+    t = l.tjd;
+    elong = target;
+    k++;
+  }
+  return result;
+}
+
+std::map<std::string, std::vector<double>> swe_transit_scan(const std::vector<double> &natal, const std::vector<int> &bodies,
+                                                            const std::vector<double> &aspects, const std::vector<double> &orbs,
+                                                            double tjd_start, double tjd_end, int iflag) {
+  if (aspects.size() != orbs.size()) {
+    throw std::runtime_error("aspects and orbs must have the same length.");
+  }
+  if (!(tjd_end > tjd_start)) {
+    throw std::runtime_error("tjd_end must be later than tjd_start.");
+  }
+  // an aspect of a degrees is formed on both sides of the natal point
+  std::vector<AspectTarget> targets;
+  for (size_t i = 0; i < aspects.size(); i++) {
+    double a = ::swe_degnorm(aspects[i]);
+    targets.push_back({a, static_cast<int>(i), orbs[i]});
+    if (::swe_degnorm(-a) != a) {
+      targets.push_back({-a, static_cast<int>(i), orbs[i]});
+    }
+  }
+  iflag &= ~SEFLG_SPEED;
+
+  std::vector<std::vector<TransitEvent>> events;
+  if (!natal.empty() && !bodies.empty() && !targets.empty()) {
+    // slices of at least 30 days, a few per worker for load balancing
+    size_t workers = workerCount(static_cast<size_t>((tjd_end - tjd_start) / 30) + 1);
+    size_t nslices = workers * 4;
+    double span = (tjd_end - tjd_start) / nslices;
+    events.resize(nslices);
+    parallelFor(nslices, workers, [&](size_t begin, size_t end, size_t) {
+      for (size_t i = begin; i < end; i++) {
+        double te = (i + 1 == nslices) ? tjd_end : tjd_start + (i + 1) * span;
+        scanSlice(tjd_start + i * span, te, natal, bodies, targets, iflag, events[i]);
+      }
+    });
+  }
+
+  std::vector<TransitEvent> merged;
+  for (auto &slice : events) {
+    merged.insert(merged.end(), slice.begin(), slice.end());
+  }
+  std::stable_sort(merged.begin(), merged.end(), [](const TransitEvent &a, const TransitEvent &b) {
+    return a.tjd < b.tjd;
+  });
+  std::map<std::string, std::vector<double>> result;
+  auto &tjd = result["tjd"], &longitude = result["longitude"], &event = result["event"];
+  auto &body = result["body"], &natalIndex = result["natal"], &aspectIndex = result["aspect"];
+  for (const auto &e : merged) {
+    tjd.push_back(e.tjd);
+    longitude.push_back(e.longitude);
+    event.push_back(e.type);
+    body.push_back(e.body);
+    natalIndex.push_back(e.natal);
+    aspectIndex.push_back(e.aspect);
+  }
+  return result;
+}
+
+} // namespace swisseph
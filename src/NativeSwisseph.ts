@@ -245,6 +245,373 @@ export interface Spec extends TurboModule {
     aphelion: number[];
   };
 
+  sweTransitScan(
+    natal: number[],
+    bodies: number[],
+    aspects: number[],
+    orbs: number[],
+    tjdStart: number,
+    tjdEnd: number,
+    iflag: number
+  ): {
+    tjd: number[];
+    longitude: number[];
+    event: number[];
+    body: number[];
+    natal: number[];
+    aspect: number[];
+  };
+
+  sweLunations(
+    tjdStart: number,
+    tjdEnd: number,
+    phases: number[],
+    iflag: number
+  ): {
+    tjd: number[];
+    phase: number[];
+    sunLongitude: number[];
+    moonLongitude: number[];
+  };
+
+  sweRiseTransCalendar(
+    tjdStart: number,
+    ndays: number,
+    geopos: number[],
+    bodies: number[],
+    epheflag: number,
+    rsmi: number,
+    atpress: number,
+    attemp: number
+  ): {
+    rise: number[];
+    set: number[];
+    mtransit: number[];
+    itransit: number[];
+  };
+
+  sweHorizonEvents(
+    tjdStart: number,
+    tjdEnd: number,
+    geopos: number[],
+    bodies: number[],
+    stars: string[],
+    epheflag: number,
+    rsmi: number,
+    atpress: number,
+    attemp: number
+  ): {
+    tjd: number[];
+    event: number[];
+    object: number[];
+  };
+
+  sweTwilightTable(
+    tjdStart: number,
+    ndays: number,
+    geopos: number[],
+    epheflag: number
+  ): {
+    civilBegin: number[];
+    civilEnd: number[];
+    nauticalBegin: number[];
+    nauticalEnd: number[];
+    astronomicalBegin: number[];
+    astronomicalEnd: number[];
+  };
+
+  sweVisLimitMagGrid(
+    tjdUt: number,
+    dgeo: number[],
+    datm: number[],
+    dobs: number[],
+    helflag: number,
+    azimuths: number[],
+    altitudes: number[]
+  ): {
+    magnitude: number[];
+    skyBrightness: number[];
+    extinction: number[];
+    airmass: number[];
+    flag: number[];
+  };
+
+  sweHeliacalCalendar(
+    tjdStart: number,
+    tjdEnd: number,
+    dgeo: number[],
+    datm: number[],
+    dobs: number[],
+    maglimit: number,
+    events: number[],
+    helflag: number
+  ): {
+    stars: string[];
+    magnitudes: number[];
+    tjd: number[];
+    optimum: number[];
+    end: number[];
+    star: number[];
+    event: number[];
+  };
+
+  sweHeliacalPhenoBatch(
+    tjdUt: number[],
+    geopos: number[],
+    datm: number[],
+    dobs: number[],
+    objectName: string,
+    eventType: number,
+    helflag: number
+  ): {
+    retflag: number[];
+    tcAltitude: number[];
+    tcApparentAltitude: number[];
+    gcAltitude: number[];
+    azimuth: number[];
+    tcSunAltitude: number[];
+    sunAzimuth: number[];
+    tcActualVisibleArc: number[];
+    gcActualVisibleArc: number[];
+    objectToSunAzimuth: number[];
+    objectToSunLongitude: number[];
+    extinction: number[];
+    tcMinVisibleArc: number[];
+    firstVisible: number[];
+    bestVisible: number[];
+    endVisible: number[];
+    yallopBestVisible: number[];
+    moonCresentWidth: number[];
+    yallopValue: number[];
+    yallopCriterion: number[];
+    parallax: number[];
+    magnitude: number[];
+    rise: number[];
+    riseSet: number[];
+    riseObjectToSun: number[];
+    visibleDuration: number[];
+    moonCresetLength: number[];
+    elong: number[];
+    illumination: number[];
+    kOZ: number[];
+    ka: number[];
+    ksumm: number[];
+  };
+
+  sweEclipseCatalogWhen(
+    file: string,
+    tjdStart: number,
+    body: number,
+    ifltype: number,
+    backward: boolean
+  ): {
+    tjd: number[];
+    type: number[];
+    magnitude: number[];
+    gamma: number[];
+    sarosSeries: number[];
+    sarosMember: number[];
+    tret: number[];
+  };
+
+  sweEclipseCatalogRange(
+    file: string,
+    tjdStart: number,
+    tjdEnd: number,
+    body: number,
+    ifltype: number
+  ): {
+    tjd: number[];
+    type: number[];
+    magnitude: number[];
+    gamma: number[];
+    sarosSeries: number[];
+    sarosMember: number[];
+    tret: number[];
+  };
+
+  sweSolEclipseMap(
+    tjdUt: number,
+    iflag: number,
+    lonStep: number,
+    latStep: number
+  ): {
+    tret: number[];
+    type: number[];
+    centralTjd: number[];
+    centralLongitude: number[];
+    centralLatitude: number[];
+    umbraNorthTjd: number[];
+    umbraNorthLongitude: number[];
+    umbraNorthLatitude: number[];
+    umbraSouthTjd: number[];
+    umbraSouthLongitude: number[];
+    umbraSouthLatitude: number[];
+    penumbraNorthTjd: number[];
+    penumbraNorthLongitude: number[];
+    penumbraNorthLatitude: number[];
+    penumbraSouthTjd: number[];
+    penumbraSouthLongitude: number[];
+    penumbraSouthLatitude: number[];
+    gridLongitude: number[];
+    gridLatitude: number[];
+    magnitude: number[];
+    obscuration: number[];
+    maxTjd: number[];
+    sunAltitude: number[];
+  };
+
+  sweLunOccultScan(
+    tjdStart: number,
+    tjdEnd: number,
+    bodies: number[],
+    stars: string[],
+    maglimit: number,
+    iflag: number
+  ): {
+    targets: string[];
+    tjd: number[];
+    type: number[];
+    target: number[];
+    tret: number[];
+  };
+
+  sweEclipseWhenLocBatch(
+    tjdUt: number,
+    body: number,
+    geopos: number[],
+    iflag: number
+  ): {
+    type: number[];
+    tret: number[];
+    magnitude: number[];
+    penumbralMagnitude: number[];
+    obscuration: number[];
+    diameterRatio: number[];
+    sunAltitude: number[];
+    moonAltitude: number[];
+  };
+
+  swePhenoBatch(
+    tjdUt: number[],
+    bodies: number[],
+    iflag: number
+  ): {
+    phaseAngle: number[];
+    phase: number[];
+    elongation: number[];
+    diameter: number[];
+    magnitude: number[];
+    parallax: number[];
+  };
+
+  sweAzaltBatch(
+    tjdUt: number[],
+    calcFlag: number,
+    geopos: number[],
+    atpress: number,
+    attemp: number,
+    xin: number[]
+  ): {
+    azimuth: number[];
+    trueAltitude: number[];
+    apparentAltitude: number[];
+  };
+
+  sweAzaltRevBatch(
+    tjdUt: number[],
+    calcFlag: number,
+    geopos: number[],
+    xin: number[]
+  ): {
+    longitude: number[];
+    latitude: number[];
+  };
+
+  sweSidtimeBatch(tjdUt: number[]): number[];
+
+  sweSidtime0Batch(
+    tjdUt: number[],
+    eps: number[],
+    nut: number[]
+  ): number[];
+
+  sweTimeEquBatch(tjdUt: number[]): number[];
+
+  sweSetMemoryLimit(nbytes: number): void;
+
+  sweGetMemoryStats(): {
+    limit: number;
+    total: number;
+    segments: number;
+    nutation: number;
+    fileBuffers: number;
+    openFiles: number;
+    fixed: number;
+  };
+
+  sweNodApsBatch(
+    tjdUt: number[],
+    bodies: number[],
+    iflag: number,
+    methods: number[]
+  ): {
+    ascending: number[];
+    descending: number[];
+    perihelion: number[];
+    aphelion: number[];
+  };
+
+  sweLunarOscBatch(
+    tjdUt: number[],
+    iflag: number
+  ): {
+    node: number[];
+    apogee: number[];
+    perigee: number[];
+  };
+
+  sweGauquelinSectorBatch(
+    tjdUt: number[],
+    geopos: number[],
+    bodies: number[],
+    iflag: number,
+    imeth: number,
+    atpress: number,
+    attemp: number
+  ): {
+    sector: number[];
+  };
+
+  sweGetStats(): {
+    enabled: number;
+    segments: number;
+    fileOpens: number;
+    readBytes: number;
+    nutation: number;
+    obliquity: number;
+    savedHits: number;
+    starScans: number;
+    riseSteps: number;
+    eclipseSteps: number;
+    calcCalls: number;
+    calcSeconds: number;
+    segmentReadsCalls: number;
+    segmentReadsSeconds: number;
+    fixstarCalls: number;
+    fixstarSeconds: number;
+    housesCalls: number;
+    housesSeconds: number;
+    riseTransCalls: number;
+    riseTransSeconds: number;
+    eclipseCalls: number;
+    eclipseSeconds: number;
+    heliacalCalls: number;
+    heliacalSeconds: number;
+  };
+
+  sweResetStats(): void;
+
   getHarmonyResfilePath(): string;
 }
 
@@ -244,6 +244,17 @@ const Swisseph = {
   TJD_INVALID: 99999999.0,
   SIMULATE_VICTORVB: 1,
 
+  // for sweTransitScan() events
+  SE_TRANSIT_ORB_ENTER: 0,
+  SE_TRANSIT_EXACT: 1,
+  SE_TRANSIT_ORB_EXIT: 2,
+
+  // for sweHorizonEvents() events
+  SE_HORIZON_RISE: 0,
+  SE_HORIZON_SET: 1,
+  SE_HORIZON_MTRANSIT: 2,
+  SE_HORIZON_ITRANSIT: 3,
+
   SE_PHOTOPIC_FLAG: 0,
   SE_SCOTOPIC_FLAG: 1,
   SE_MIXEDOPIC_FLAG: 2,
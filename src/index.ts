@@ -327,6 +327,492 @@ export function sweNodApsUt(
   return Native.sweNodApsUt(tjdUt, ipl, iflag, method);
 }
 
+export function sweTransitScan(
+  natal: number[],
+  bodies: number[],
+  aspects: number[],
+  orbs: number[],
+  tjdStart: number,
+  tjdEnd: number,
+  iflag: number
+): {
+  tjd: number[];
+  longitude: number[];
+  event: number[];
+  body: number[];
+  natal: number[];
+  aspect: number[];
+} {
+  return Native.sweTransitScan(
+    natal,
+    bodies,
+    aspects,
+    orbs,
+    tjdStart,
+    tjdEnd,
+    iflag
+  );
+}
+
+export function sweLunations(
+  tjdStart: number,
+  tjdEnd: number,
+  phases: number[],
+  iflag: number
+): {
+  tjd: number[];
+  phase: number[];
+  sunLongitude: number[];
+  moonLongitude: number[];
+} {
+  return Native.sweLunations(tjdStart, tjdEnd, phases, iflag);
+}
+
+export function sweRiseTransCalendar(
+  tjdStart: number,
+  ndays: number,
+  geopos: number[],
+  bodies: number[],
+  epheflag: number,
+  rsmi: number,
+  atpress: number,
+  attemp: number
+): {
+  rise: number[];
+  set: number[];
+  mtransit: number[];
+  itransit: number[];
+} {
+  return Native.sweRiseTransCalendar(
+    tjdStart,
+    ndays,
+    geopos,
+    bodies,
+    epheflag,
+    rsmi,
+    atpress,
+    attemp
+  );
+}
+
+export function sweHorizonEvents(
+  tjdStart: number,
+  tjdEnd: number,
+  geopos: number[],
+  bodies: number[],
+  stars: string[],
+  epheflag: number,
+  rsmi: number,
+  atpress: number,
+  attemp: number
+): {
+  tjd: number[];
+  event: number[];
+  object: number[];
+} {
+  return Native.sweHorizonEvents(
+    tjdStart,
+    tjdEnd,
+    geopos,
+    bodies,
+    stars,
+    epheflag,
+    rsmi,
+    atpress,
+    attemp
+  );
+}
+
+export function sweTwilightTable(
+  tjdStart: number,
+  ndays: number,
+  geopos: number[],
+  epheflag: number
+): {
+  civilBegin: number[];
+  civilEnd: number[];
+  nauticalBegin: number[];
+  nauticalEnd: number[];
+  astronomicalBegin: number[];
+  astronomicalEnd: number[];
+} {
+  return Native.sweTwilightTable(tjdStart, ndays, geopos, epheflag);
+}
+
+export function sweVisLimitMagGrid(
+  tjdUt: number,
+  dgeo: number[],
+  datm: number[],
+  dobs: number[],
+  helflag: number,
+  azimuths: number[],
+  altitudes: number[]
+): {
+  magnitude: number[];
+  skyBrightness: number[];
+  extinction: number[];
+  airmass: number[];
+  flag: number[];
+} {
+  return Native.sweVisLimitMagGrid(
+    tjdUt,
+    dgeo,
+    datm,
+    dobs,
+    helflag,
+    azimuths,
+    altitudes
+  );
+}
+
+export function sweHeliacalCalendar(
+  tjdStart: number,
+  tjdEnd: number,
+  dgeo: number[],
+  datm: number[],
+  dobs: number[],
+  maglimit: number,
+  events: number[],
+  helflag: number
+): {
+  stars: string[];
+  magnitudes: number[];
+  tjd: number[];
+  optimum: number[];
+  end: number[];
+  star: number[];
+  event: number[];
+} {
+  return Native.sweHeliacalCalendar(
+    tjdStart,
+    tjdEnd,
+    dgeo,
+    datm,
+    dobs,
+    maglimit,
+    events,
+    helflag
+  );
+}
+
+export function sweHeliacalPhenoBatch(
+  tjdUt: number[],
+  geopos: number[],
+  datm: number[],
+  dobs: number[],
+  objectName: string,
+  eventType: number,
+  helflag: number
+): {
+  retflag: number[];
+  tcAltitude: number[];
+  tcApparentAltitude: number[];
+  gcAltitude: number[];
+  azimuth: number[];
+  tcSunAltitude: number[];
+  sunAzimuth: number[];
+  tcActualVisibleArc: number[];
+  gcActualVisibleArc: number[];
+  objectToSunAzimuth: number[];
+  objectToSunLongitude: number[];
+  extinction: number[];
+  tcMinVisibleArc: number[];
+  firstVisible: number[];
+  bestVisible: number[];
+  endVisible: number[];
+  yallopBestVisible: number[];
+  moonCresentWidth: number[];
+  yallopValue: number[];
+  yallopCriterion: number[];
+  parallax: number[];
+  magnitude: number[];
+  rise: number[];
+  riseSet: number[];
+  riseObjectToSun: number[];
+  visibleDuration: number[];
+  moonCresetLength: number[];
+  elong: number[];
+  illumination: number[];
+  kOZ: number[];
+  ka: number[];
+  ksumm: number[];
+} {
+  return Native.sweHeliacalPhenoBatch(
+    tjdUt,
+    geopos,
+    datm,
+    dobs,
+    objectName,
+    eventType,
+    helflag
+  );
+}
+
+export function sweEclipseCatalogWhen(
+  file: string,
+  tjdStart: number,
+  body: number,
+  ifltype: number,
+  backward: boolean
+): {
+  tjd: number[];
+  type: number[];
+  magnitude: number[];
+  gamma: number[];
+  sarosSeries: number[];
+  sarosMember: number[];
+  tret: number[];
+} {
+  return Native.sweEclipseCatalogWhen(file, tjdStart, body, ifltype, backward);
+}
+
+export function sweEclipseCatalogRange(
+  file: string,
+  tjdStart: number,
+  tjdEnd: number,
+  body: number,
+  ifltype: number
+): {
+  tjd: number[];
+  type: number[];
+  magnitude: number[];
+  gamma: number[];
+  sarosSeries: number[];
+  sarosMember: number[];
+  tret: number[];
+} {
+  return Native.sweEclipseCatalogRange(file, tjdStart, tjdEnd, body, ifltype);
+}
+
+export function sweSolEclipseMap(
+  tjdUt: number,
+  iflag: number,
+  lonStep: number,
+  latStep: number
+): {
+  tret: number[];
+  type: number[];
+  centralTjd: number[];
+  centralLongitude: number[];
+  centralLatitude: number[];
+  umbraNorthTjd: number[];
+  umbraNorthLongitude: number[];
+  umbraNorthLatitude: number[];
+  umbraSouthTjd: number[];
+  umbraSouthLongitude: number[];
+  umbraSouthLatitude: number[];
+  penumbraNorthTjd: number[];
+  penumbraNorthLongitude: number[];
+  penumbraNorthLatitude: number[];
+  penumbraSouthTjd: number[];
+  penumbraSouthLongitude: number[];
+  penumbraSouthLatitude: number[];
+  gridLongitude: number[];
+  gridLatitude: number[];
+  magnitude: number[];
+  obscuration: number[];
+  maxTjd: number[];
+  sunAltitude: number[];
+} {
+  return Native.sweSolEclipseMap(tjdUt, iflag, lonStep, latStep);
+}
+
+export function sweLunOccultScan(
+  tjdStart: number,
+  tjdEnd: number,
+  bodies: number[],
+  stars: string[],
+  maglimit: number,
+  iflag: number
+): {
+  targets: string[];
+  tjd: number[];
+  type: number[];
+  target: number[];
+  tret: number[];
+} {
+  return Native.sweLunOccultScan(
+    tjdStart,
+    tjdEnd,
+    bodies,
+    stars,
+    maglimit,
+    iflag
+  );
+}
+
+export function sweEclipseWhenLocBatch(
+  tjdUt: number,
+  body: number,
+  geopos: number[],
+  iflag: number
+): {
+  type: number[];
+  tret: number[];
+  magnitude: number[];
+  penumbralMagnitude: number[];
+  obscuration: number[];
+  diameterRatio: number[];
+  sunAltitude: number[];
+  moonAltitude: number[];
+} {
+  return Native.sweEclipseWhenLocBatch(tjdUt, body, geopos, iflag);
+}
+
+export function swePhenoBatch(
+  tjdUt: number[],
+  bodies: number[],
+  iflag: number
+): {
+  phaseAngle: number[];
+  phase: number[];
+  elongation: number[];
+  diameter: number[];
+  magnitude: number[];
+  parallax: number[];
+} {
+  return Native.swePhenoBatch(tjdUt, bodies, iflag);
+}
+
+export function sweAzaltBatch(
+  tjdUt: number[],
+  calcFlag: number,
+  geopos: number[],
+  atpress: number,
+  attemp: number,
+  xin: number[]
+): {
+  azimuth: number[];
+  trueAltitude: number[];
+  apparentAltitude: number[];
+} {
+  return Native.sweAzaltBatch(tjdUt, calcFlag, geopos, atpress, attemp, xin);
+}
+
+export function sweAzaltRevBatch(
+  tjdUt: number[],
+  calcFlag: number,
+  geopos: number[],
+  xin: number[]
+): {
+  longitude: number[];
+  latitude: number[];
+} {
+  return Native.sweAzaltRevBatch(tjdUt, calcFlag, geopos, xin);
+}
+
+export function sweSidtimeBatch(tjdUt: number[]): number[] {
+  return Native.sweSidtimeBatch(tjdUt);
+}
+
+export function sweSidtime0Batch(
+  tjdUt: number[],
+  eps: number[],
+  nut: number[]
+): number[] {
+  return Native.sweSidtime0Batch(tjdUt, eps, nut);
+}
+
+export function sweTimeEquBatch(tjdUt: number[]): number[] {
+  return Native.sweTimeEquBatch(tjdUt);
+}
+
+export function sweSetMemoryLimit(nbytes: number): void {
+  return Native.sweSetMemoryLimit(nbytes);
+}
+
+export function sweGetMemoryStats(): {
+  limit: number;
+  total: number;
+  segments: number;
+  nutation: number;
+  fileBuffers: number;
+  openFiles: number;
+  fixed: number;
+} {
+  return Native.sweGetMemoryStats();
+}
+
+export function sweNodApsBatch(
+  tjdUt: number[],
+  bodies: number[],
+  iflag: number,
+  methods: number[]
+): {
+  ascending: number[];
+  descending: number[];
+  perihelion: number[];
+  aphelion: number[];
+} {
+  return Native.sweNodApsBatch(tjdUt, bodies, iflag, methods);
+}
+
+export function sweLunarOscBatch(
+  tjdUt: number[],
+  iflag: number
+): {
+  node: number[];
+  apogee: number[];
+  perigee: number[];
+} {
+  return Native.sweLunarOscBatch(tjdUt, iflag);
+}
+
+export function sweGauquelinSectorBatch(
+  tjdUt: number[],
+  geopos: number[],
+  bodies: number[],
+  iflag: number,
+  imeth: number,
+  atpress: number,
+  attemp: number
+): {
+  sector: number[];
+} {
+  return Native.sweGauquelinSectorBatch(
+    tjdUt,
+    geopos,
+    bodies,
+    iflag,
+    imeth,
+    atpress,
+    attemp
+  );
+}
+
+export function sweGetStats(): {
+  enabled: number;
+  segments: number;
+  fileOpens: number;
+  readBytes: number;
+  nutation: number;
+  obliquity: number;
+  savedHits: number;
+  starScans: number;
+  riseSteps: number;
+  eclipseSteps: number;
+  calcCalls: number;
+  calcSeconds: number;
+  segmentReadsCalls: number;
+  segmentReadsSeconds: number;
+  fixstarCalls: number;
+  fixstarSeconds: number;
+  housesCalls: number;
+  housesSeconds: number;
+  riseTransCalls: number;
+  riseTransSeconds: number;
+  eclipseCalls: number;
+  eclipseSeconds: number;
+  heliacalCalls: number;
+  heliacalSeconds: number;
+} {
+  return Native.sweGetStats();
+}
+
+export function sweResetStats(): void {
+  return Native.sweResetStats();
+}
+
 export function getHarmonyResfilePath(): string {
   // @ts-ignore
   if (Platform.OS === 'harmony') {
@@ -363,6 +849,32 @@ export default {
   sweHeliacalUt,
   sweVisLimitMag,
   sweNodApsUt,
+  sweTransitScan,
+  sweLunations,
+  sweRiseTransCalendar,
+  sweHorizonEvents,
+  sweTwilightTable,
+  sweVisLimitMagGrid,
+  sweHeliacalCalendar,
+  sweHeliacalPhenoBatch,
+  sweEclipseCatalogWhen,
+  sweEclipseCatalogRange,
+  sweSolEclipseMap,
+  sweLunOccultScan,
+  sweEclipseWhenLocBatch,
+  swePhenoBatch,
+  sweAzaltBatch,
+  sweAzaltRevBatch,
+  sweSidtimeBatch,
+  sweSidtime0Batch,
+  sweTimeEquBatch,
+  sweSetMemoryLimit,
+  sweGetMemoryStats,
+  sweNodApsBatch,
+  sweLunarOscBatch,
+  sweGauquelinSectorBatch,
+  sweGetStats,
+  sweResetStats,
   getHarmonyResfilePath,
   ...SwissephLib,
 };
@@ -72,6 +72,9 @@ static int find_zero(double y00, double y11, double y2, double dx,
 			double *dxret, double *dxret2);
 static double calc_dip(double geoalt, double atpress, double attemp, double lapse_rate);
 static double calc_astronomical_refr(double geoalt,double atpress, double attemp);
+static double calc_refr_true_to_app(double inalt, double atpress, double attemp, int niter);
+struct refr_table;
+static double refrac_extended(double inalt, double dip, double atpress, double attemp, int32 calc_flag, double *dret, struct refr_table *tab);
 static TLS double const_lapse_rate = SE_LAPSE_RATE;  /* for refraction */
 
 #if 0
@@ -1148,7 +1151,7 @@ static int32 eclipse_how( double tjd_ut, int32 ipl, char *starname, int32 ifl,
  *         declare as tret[10] at least!
  *
  */
-int32 swe_sol_eclipse_when_glob(double tjd_start, int32 ifl, int32 ifltype,
+static int32 sol_eclipse_when_glob(double tjd_start, int32 ifl, int32 ifltype,
      double *tret, int32 backward, char *serr)
 {
   int i, j, k, m, n, o, i1 = 0, i2 = 0;
@@ -1195,6 +1198,7 @@ int32 swe_sol_eclipse_when_glob(double tjd_start, int32 ifl, int32 ifltype,
   K = (int) ((tjd_start - J2000) / 365.2425 * 12.3685);
   K -= direction;
 next_try:
+  SWI_STATS_ADD(SE_STAT_ECLIPSE_STEPS, 1);
   retflag = 0;
   dont_times = FALSE;
   for (i = 0; i <= 9; i++)
@@ -1480,6 +1484,15 @@ end_search_global:
    */
 }
 
+int32 swe_sol_eclipse_when_glob(double tjd_start, int32 ifl, int32 ifltype,
+     double *tret, int32 backward, char *serr)
+{
+  int32 retflag;
+  SWI_STATS_TIMED(SE_STAT_TIME_ECLIPSE, 
+    retflag = sol_eclipse_when_glob(tjd_start, ifl, ifltype, tret, backward, serr));
+  return retflag;
+}
+
 /* When is the next lunar occultation anywhere on earth?
  * This function also finds solar eclipses, but is less efficient
  * than swe_sol_eclipse_when_glob().
@@ -1535,7 +1548,7 @@ end_search_global:
  *         declare as tret[10] at least!
  *
  */
-int32 swe_lun_occult_when_glob(
+static int32 lun_occult_when_glob(
      double tjd_start, int32 ipl, char *starname, int32 ifl, int32 ifltype,
      double *tret, int32 backward, char *serr)
 {
@@ -1604,6 +1617,7 @@ int32 swe_lun_occult_when_glob(
   t = tjd_start;
   tjd = t;
 next_try:
+  SWI_STATS_ADD(SE_STAT_ECLIPSE_STEPS, 1);
   if (calc_planet_star(t, ipl, starname, ifl, ls, serr) == ERR)
       return ERR;
   /* fixed stars with an ecliptic latitude > 7  or < -7 cannot have 
@@ -1949,6 +1963,16 @@ end_search_global:
    */
 }
 
+int32 swe_lun_occult_when_glob(
+     double tjd_start, int32 ipl, char *starname, int32 ifl, int32 ifltype,
+     double *tret, int32 backward, char *serr)
+{
+  int32 retflag;
+  SWI_STATS_TIMED(SE_STAT_TIME_ECLIPSE, 
+    retflag = lun_occult_when_glob(tjd_start, ipl, starname, ifl, ifltype, tret, backward, serr));
+  return retflag;
+}
+
 /* When is the next solar eclipse at a given geographical position?
  * Note the uncertainty of Delta T for the remote past and for
  * the future.
@@ -1994,7 +2018,9 @@ int32 swe_sol_eclipse_when_loc(double tjd_start, int32 ifl,
   }
   ifl &= SEFLG_EPHMASK; 
   swi_set_tid_acc(tjd_start, ifl, 0, serr);
-  if ((retflag = eclipse_when_loc(tjd_start, ifl, geopos, tret, attr, backward, serr)) <= 0)
+  SWI_STATS_TIMED(SE_STAT_TIME_ECLIPSE, 
+    retflag = eclipse_when_loc(tjd_start, ifl, geopos, tret, attr, backward, serr));
+  if (retflag <= 0)
     return retflag;
   /* 
    * diameter of core shadow
@@ -2051,7 +2077,9 @@ int32 swe_lun_occult_when_loc(double tjd_start, int32 ipl, char *starname, int32
     ipl = SE_PLUTO;
   ifl &= SEFLG_EPHMASK; 
   swi_set_tid_acc(tjd_start, ifl, 0, serr);
-  if ((retflag = occult_when_loc(tjd_start, ipl, starname, ifl, geopos, tret, attr, backward, serr)) <= 0)
+  SWI_STATS_TIMED(SE_STAT_TIME_ECLIPSE, 
+    retflag = occult_when_loc(tjd_start, ipl, starname, ifl, geopos, tret, attr, backward, serr));
+  if (retflag <= 0)
     return retflag;
   /* 
    * diameter of core shadow
@@ -2087,6 +2115,7 @@ static int32 eclipse_when_loc(double tjd_start, int32 ifl, double *geopos, doubl
   else
     K--;
 next_try:
+  SWI_STATS_ADD(SE_STAT_ECLIPSE_STEPS, 1);
   T = K / 1236.85;
   T2 = T * T; T3 = T2 * T; T4 = T3 * T;
   Ff = F = swe_degnorm(160.7108 + 390.67050274 * K
@@ -2413,6 +2442,7 @@ static int32 occult_when_loc(
   t = tjd_start;
   tjd = tjd_start;
 next_try:
+  SWI_STATS_ADD(SE_STAT_ECLIPSE_STEPS, 1);
   is_partial = FALSE;
   if (calc_planet_star(t, ipl, starname, iflaggeo, ls, serr) == ERR)
       return ERR;
@@ -2783,7 +2813,7 @@ void swe_azalt(
     /* estimate atmospheric pressure */
     atpress = 1013.25 * pow(1 - 0.0065 * geopos[2] / 288, 5.255);
   } 
-  xaz[2] = swe_refrac_extended(x[1], geopos[2], atpress, attemp, const_lapse_rate, SE_TRUE_TO_APP, NULL);
+  xaz[2] = swi_refrac_extended(x[1], geopos[2], atpress, attemp, const_lapse_rate, SE_TRUE_TO_APP, NULL);
   /* xaz[2] = swe_refrac_extended(xaz[2], geopos[2], atpress, attemp, const_lapse_rate, SE_APP_TO_TRUE, NULL);*/
 }
 
@@ -2995,11 +3025,130 @@ void swe_set_lapse_rate(double lapse_rate)
  */
 double swe_refrac_extended(double inalt, double geoalt, double atpress, double attemp, double lapse_rate, int32 calc_flag, double *dret)
 {
-  double refr;
-  double trualt;
   double dip = calc_dip(geoalt, atpress, attemp, lapse_rate);
-  double D, D0, N, y, yy0;
+  return refrac_extended(inalt, dip, atpress, attemp, calc_flag, dret, NULL);
+}
+
+/* swi_refrac_extended()
+ * Same as swe_refrac_extended(), but the refraction of true altitudes 
+ * (SE_TRUE_TO_APP), which otherwise needs an iteration on every call, 
+ * is interpolated in a table kept for the atmosphere (atpress, attemp, 
+ * lapse_rate) and observer height geoalt. The table is filled lazily, 
+ * a few nodes at a time, so that a caller that only looks at altitudes 
+ * near the horizon does not pay for the rest. Tables for the last 
+ * REFR_NTAB atmospheres are kept.
+ * Refraction is sampled every 1/16 degree of true altitude from -10 to 
+ * 20 degrees, and every 1/2 degree from 20 to 90 degrees, and interpolated 
+ * with cubic polynomials; the nodes are iterated to convergence. The 
+ * interpolation error is below 0.0001" wherever the true altitude 
+ * determines the apparent one (very cold, dense air refracts by more than 
+ * a degree below the horizon, where this fails). Close to the bend of 
+ * Sinclair's formula at apparent altitude 17.9 deg, where a polynomial 
+ * does not fit, the refraction is computed without the table. 
+ * The result can differ from swe_refrac_extended() by more than that, 
+ * because the 5 iterations there do not always converge: near the horizon 
+ * in cold air, its error reaches 0.3" at -40 C. 
+ * The conversion of apparent altitudes (SE_APP_TO_TRUE) needs no 
+ * iteration and is not tabulated.
+ * Used by swe_azalt(), and through it by the rise and set and the 
+ * heliacal functions.
+ */
+#define REFR_NTAB	4
+#define REFR_FINE_STEP	0.0625
+#define REFR_FINE_N	480	/* -10 .. 20 deg */
+#define REFR_COARSE_STEP	0.5
+#define REFR_NNODES	(REFR_FINE_N + 141)	/* 20 .. 90 deg */
+#define REFR_NITER	20
+#define REFR_SINCLAIR_BEND	17.904104638432	/* see calc_astronomical_refr() */
+struct refr_table {
+  double atpress, attemp, lapse_rate, geoalt;
+  double dip;
+  double bend;			/* true altitude of the bend */
+  double refr[REFR_NNODES];	/* refraction at true altitude of node, 
+				 * or HUGE if not yet computed */
+};
+static TLS struct refr_table refr_tab[REFR_NTAB];
+static TLS int refr_tab_used = 0, refr_tab_next = 0;
+
+static struct refr_table *get_refr_table(double geoalt, double atpress, double attemp, double lapse_rate)
+{
   int i;
+  struct refr_table *t;
+  for (i = 0; i < refr_tab_used; i++) {
+    t = &refr_tab[i];
+    if (t->atpress == atpress && t->attemp == attemp 
+      && t->lapse_rate == lapse_rate && t->geoalt == geoalt)
+      return t;
+  }
+  t = &refr_tab[refr_tab_next];
+  refr_tab_next = (refr_tab_next + 1) % REFR_NTAB;
+  if (refr_tab_used < REFR_NTAB)
+    refr_tab_used++;
+  t->atpress = atpress;
+  t->attemp = attemp;
+  t->lapse_rate = lapse_rate;
+  t->geoalt = geoalt;
+  t->dip = calc_dip(geoalt, atpress, attemp, lapse_rate);
+  t->bend = REFR_SINCLAIR_BEND - calc_astronomical_refr(REFR_SINCLAIR_BEND, atpress, attemp);
+  for (i = 0; i < REFR_NNODES; i++)
+    t->refr[i] = HUGE;
+  return t;
+}
+
+static double refr_table_node(struct refr_table *t, int i)
+{
+  double alt;
+  if (t->refr[i] == HUGE) {
+    if (i <= REFR_FINE_N)
+      alt = -10 + i * REFR_FINE_STEP;
+    else
+      alt = 20 + (i - REFR_FINE_N) * REFR_COARSE_STEP;
+    t->refr[i] = calc_refr_true_to_app(alt, t->atpress, t->attemp, REFR_NITER);
+  }
+  return t->refr[i];
+}
+
+/* refraction at true altitude inalt, -10 <= inalt <= 90 */
+static double refr_table_lookup(struct refr_table *t, double inalt)
+{
+  int i, i0, i1;
+  double u, y0, y1, y2, y3;
+  if (fabs(inalt - t->bend) < 2 * REFR_FINE_STEP)
+    return calc_refr_true_to_app(inalt, t->atpress, t->attemp, REFR_NITER);
+  if (inalt < 20) {
+    u = (inalt + 10) / REFR_FINE_STEP;
+    i0 = 0; i1 = REFR_FINE_N;
+  } else {
+    u = REFR_FINE_N + (inalt - 20) / REFR_COARSE_STEP;
+    i0 = REFR_FINE_N; i1 = REFR_NNODES - 1;
+  }
+  /* four nodes i-1 .. i+2 of the same step around inalt */
+  i = (int) floor(u);
+  if (i < i0 + 1) 
+    i = i0 + 1;
+  if (i > i1 - 2) 
+    i = i1 - 2;
+  u -= i;
+  y0 = refr_table_node(t, i - 1);
+  y1 = refr_table_node(t, i);
+  y2 = refr_table_node(t, i + 1);
+  y3 = refr_table_node(t, i + 2);
+  /* Lagrange interpolation at nodes -1, 0, 1, 2 */
+  return y1 + u * ((y2 - y0) / 2 
+    + u * ((y0 + y2) / 2 - y1) 
+    + (u * u - 1) * ((y3 - y0) / 6 + (y1 - y2) / 2));
+}
+
+double swi_refrac_extended(double inalt, double geoalt, double atpress, double attemp, double lapse_rate, int32 calc_flag, double *dret)
+{
+  struct refr_table *t = get_refr_table(geoalt, atpress, attemp, lapse_rate);
+  return refrac_extended(inalt, t->dip, atpress, attemp, calc_flag, dret, t);
+}
+
+static double refrac_extended(double inalt, double dip, double atpress, double attemp, int32 calc_flag, double *dret, struct refr_table *tab)
+{
+  double refr;
+  double trualt;
   /* make sure that inalt <=90 */
   if( (inalt>90) )
     inalt=180-inalt;
@@ -3013,24 +3162,10 @@ double swe_refrac_extended(double inalt, double geoalt, double atpress, double a
       }
       return inalt;
     }
-    /* by iteration */
-    y = inalt;
-    D = 0.0;
-    yy0 = 0;
-    D0 = D;
-    for(i=0; i<5; i++) {
-      D = calc_astronomical_refr(y,atpress,attemp);
-      N = y - yy0;
-      yy0 = D - D0 - N; /* denominator of derivative */
-      if (N != 0.0 && yy0 != 0.0) /* sic !!! code by Moshier */
-        N = y - N*(inalt + D - y)/yy0; /* Newton iteration with numerically estimated derivative */
-      else /* Can't do it on first pass */
-        N = inalt + D;
-      yy0 = y;
-      D0 = D;
-      y = N;
-    }
-    refr = D;
+    if (tab != NULL)
+      refr = refr_table_lookup(tab, inalt);
+    else
+      refr = calc_refr_true_to_app(inalt, atpress, attemp, 5);
     if( (inalt + refr < dip) ) {
       if (dret != NULL) {
 	dret[0]=inalt;
@@ -3070,6 +3205,31 @@ double swe_refrac_extended(double inalt, double geoalt, double atpress, double a
   }
 }
 
+/* refraction of an object at true altitude inalt, i.e. the solution of
+ * app = inalt + calc_astronomical_refr(app), by niter iterations */
+static double calc_refr_true_to_app(double inalt, double atpress, double attemp, int niter)
+{
+  double D, D0, N, y, yy0;
+  int i;
+  y = inalt;
+  D = 0.0;
+  yy0 = 0;
+  D0 = D;
+  for(i=0; i<niter; i++) {
+    D = calc_astronomical_refr(y,atpress,attemp);
+    N = y - yy0;
+    yy0 = D - D0 - N; /* denominator of derivative */
+    if (N != 0.0 && yy0 != 0.0) /* sic !!! code by Moshier */
+      N = y - N*(inalt + D - y)/yy0; /* Newton iteration with numerically estimated derivative */
+    else /* Can't do it on first pass */
+      N = inalt + D;
+    yy0 = y;
+    D0 = D;
+    y = N;
+  }
+  return D;
+}
+
 /* calculate the astronomical refraction
  * input parameters:
  * double inalt        * apparent altitude of object
@@ -3093,7 +3253,7 @@ static double calc_astronomical_refr(double inalt,double atpress, double attemp)
   /* Formula by Sinclair, see article mentioned above, p. 256. Better for 
    * apparent altitudes < 0;  */
   double r;
-  if (inalt > 17.904104638432) { /* for continuous function, instead of '>15' */
+  if (inalt > REFR_SINCLAIR_BEND) { /* for continuous function, instead of '>15' */
     r = 0.97 / tan(inalt * DEGTORAD);
   } else {
     r = (34.46 + 4.23 * inalt + 0.004 * inalt * inalt) / (1 + 0.505 * inalt + 0.0845 * inalt * inalt);
@@ -3330,7 +3490,7 @@ static int32 lun_eclipse_how(
  * tret[6]	time of penumbral phase begin
  * tret[7]	time of penumbral phase end
  */
-int32 swe_lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype,
+static int32 lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype,
      double *tret, int32 backward, char *serr)
 {
   int i, j, m, n, o, i1 = 0, i2 = 0;
@@ -3372,6 +3532,7 @@ int32 swe_lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype,
   K = (int) ((tjd_start - J2000) / 365.2425 * 12.3685);
   K -= direction;
 next_try:
+  SWI_STATS_ADD(SE_STAT_ECLIPSE_STEPS, 1);
   retflag = 0;
   for (i = 0; i <= 9; i++)
     tret[i] = 0;
@@ -3559,6 +3720,15 @@ next_try:
   return retflag;
 }
 
+int32 swe_lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype,
+     double *tret, int32 backward, char *serr)
+{
+  int32 retflag;
+  SWI_STATS_TIMED(SE_STAT_TIME_ECLIPSE, 
+    retflag = lun_eclipse_when(tjd_start, ifl, ifltype, tret, backward, serr));
+  return retflag;
+}
+
 /* When is the next lunar eclipse, observable at a geographic position?
  *
  * retflag	SE_ECL_TOTAL or SE_ECL_PENUMBRAL or SE_ECL_PARTIAL
@@ -4057,9 +4227,7 @@ int32 swe_rise_trans(
   return swe_rise_trans_true_hor(tjd_ut, ipl, starname, epheflag, rsmi, geopos, atpress, attemp, 0, tret, serr);
 }
 
-/* same as swe_rise_trans(), but allows to define the height of the horizon
- * at the point of the rising or setting (horhgt) */
-int32 swe_rise_trans_true_hor(
+static int32 rise_trans_true_hor(
                double tjd_ut, int32 ipl, char *starname,
 	       int32 epheflag, int32 rsmi,
                double *geopos, 
@@ -4118,6 +4286,7 @@ int32 swe_rise_trans_true_hor(
       return ERR;
   } 
   for (ii = 0, t = tjd_ut - twohrs; ii <= jmax; ii++, t += twohrs) {
+    SWI_STATS_ADD(SE_STAT_RISE_STEPS, 1);
     tc[ii] = t;
     if (!do_fixstar) {
       te = t + swe_deltat_ex(t, epheflag, serr);
@@ -4185,6 +4354,7 @@ int32 swe_rise_trans_true_hor(
       dt /= 3;
       for (; dt > 0.0001; dt /= 3) {
         for (i = 0, tt = tcu - dt; i < 3; tt += dt, i++) {
+          SWI_STATS_ADD(SE_STAT_RISE_STEPS, 1);
           te = tt + swe_deltat_ex(tt, epheflag, serr);
           if (!do_fixstar)
             if (swe_calc(te, ipl, iflag, xc, serr) == ERR)
@@ -4267,6 +4437,7 @@ int32 swe_rise_trans_true_hor(
     t2[0] = tc[ii-1];
     t2[1] = tc[ii];
     for (i = 0; i < 20; i++) {
+      SWI_STATS_ADD(SE_STAT_RISE_STEPS, 1);
       t = (t2[0] + t2[1]) / 2;
       if (!do_fixstar) {
         te = t + swe_deltat_ex(t, epheflag, serr);
@@ -4321,6 +4492,24 @@ int32 swe_rise_trans_true_hor(
   return -2; /* no t of rise or set found */
 }
 
+/* same as swe_rise_trans(), but allows to define the height of the horizon
+ * at the point of the rising or setting (horhgt) */
+int32 swe_rise_trans_true_hor(
+               double tjd_ut, int32 ipl, char *starname,
+	       int32 epheflag, int32 rsmi,
+               double *geopos, 
+	       double atpress, double attemp,
+	       double horhgt,
+               double *tret,
+               char *serr)
+{
+  int32 retc;
+  SWI_STATS_TIMED(SE_STAT_TIME_RISE_TRANS, 
+    retc = rise_trans_true_hor(tjd_ut, ipl, starname, epheflag, rsmi, 
+		geopos, atpress, attemp, horhgt, tret, serr));
+  return retc;
+}
+
 static int32 calc_mer_trans(
                double tjd_ut, int32 ipl, int32 epheflag, int32 rsmi,
                double *geopos,
@@ -4360,6 +4549,7 @@ static int32 calc_mer_trans(
     if (rsmi & SE_CALC_ITRANSIT)
       arxc = swe_degnorm(arxc + 180);
     for (i = 0; i < 4; i++) {
+      SWI_STATS_ADD(SE_STAT_RISE_STEPS, 1);
       mdd = swe_degnorm(x[0] - arxc);
       if (i > 0 && mdd > 180)
         mdd -= 360;
@@ -4697,89 +4887,99 @@ static const double plmass[9] = {
   130000000,        /* Pluto */
 };
 static const int ipl_to_elem[15] = {2, 0, 0, 1, 3, 4, 5, 6, 7, 0, 0, 0, 0, 0, 2,};
-int32 swe_nod_aps(double tjd_et, int32 ipl, int32 iflag, 
-                      int32  method,
-                      double *xnasc, double *xndsc, 
-                      double *xperi, double *xaphe, 
-                      char *serr)
+
+/* positions of a body that all osculating methods of swe_nod_aps_batch()
+ * can share */
+struct nod_aps_osc {
+  int32 ipli;
+  int32 dist_iflag;
+  double dist;		/* heliocentric distance */
+  int32 iflJ2000;	/* 0 if xpos[] is not set */
+  double xpos[3][6];
+};
+
+/* samples of barycentric earth and sun at tjd_et - i * NOD_APS_STEP,
+ * which swe_nod_aps_batch() interpolates for the apparent speed of 
+ * all nodes and apsides of an epoch */
+#define NOD_APS_STEP	0.25
+#define NOD_APS_NSAMP	3
+struct nod_aps_epoch {
+  int nsamp;		/* 0 if there are no samples */
+  double xear[NOD_APS_NSAMP][6];
+  double xsun[NOD_APS_NSAMP][6];
+};
+
+/* quadratic interpolation of the samples for tjd_et - dt */
+static void nod_aps_interpol(struct nod_aps_epoch *ep, double dt, double *xear, double *xsun)
 {
-  int ij, i, j;
+  int i;
+  double u = dt / NOD_APS_STEP;
+  for (i = 0; i <= 5; i++) {
+    xear[i] = ep->xear[0][i] + u * (ep->xear[1][i] - ep->xear[0][i])
+      + u * (u - 1) / 2 * (ep->xear[2][i] - 2 * ep->xear[1][i] + ep->xear[0][i]);
+    xsun[i] = ep->xsun[0][i] + u * (ep->xsun[1][i] - ep->xsun[0][i])
+      + u * (u - 1) / 2 * (ep->xsun[2][i] - 2 * ep->xsun[1][i] + ep->xsun[0][i]);
+  }
+}
+
+static int32 nod_aps_check(int32 ipl, char *serr)
+{
+  if (ipl == SE_MEAN_NODE || ipl == SE_TRUE_NODE || 
+	  ipl == SE_MEAN_APOG || ipl == SE_OSCU_APOG || 
+	  ipl < 0 || 
+	  (ipl >= SE_NPLANETS && ipl <= SE_AST_OFFSET)) {
+	  /*(ipl >= SE_FICT_OFFSET && ipl - SE_FICT_OFFSET < SE_NFICT_ELEM)) */
+    if (serr != NULL)
+      sprintf(serr, "nodes/apsides for planet %5.0f are not implemented", (double) ipl);
+    return ERR;
+  }
+  return OK;
+}
+
+/* nodes and apsides in xx[24] (ascending node, descending node, 
+ * perihelion, aphelion), heliocentric, ecliptic of date for the mean 
+ * points or J2000 for the osculating ones (*is_true_nodaps).
+ * osc may hold positions of a previous call for the same date. */
+static int32 nod_aps_orbit(double tjd_et, int32 ipl, int32 iflag, 
+                      int32 method, double *xx,
+                      AS_BOOL *is_true_nodaps, AS_BOOL *ellipse_is_bary,
+                      struct nod_aps_osc *osc, char *serr)
+{
+  int i, j;
   int32 iplx;
   int32 ipli;
   int istart, iend;
   int32 iflJ2000;
-  double daya, plm;
+  double plm;
   double t = (tjd_et - J2000) / 36525, dt;
-  double x[6], xx[24], *xp, xobs[6], x2000[6]; 
+  double x[6], *xp;
   double xpos[3][6], xnorm[6];
   double xposm[6];
   double xn[3][6], xs[3][6];
   double xq[3][6], xa[3][6];
-  double xobs2[6], x2[6];
   double *xna, *xnd, *xpe, *xap;
   double incl, sema, ecce, parg, ea, vincl, vsema, vecce, pargx, eax;
-  struct plan_data *pedp = &swed.pldat[SEI_EARTH];
-  struct plan_data *psbdp = &swed.pldat[SEI_SUNBARY];
-  struct plan_data pldat;
-  double *xsun = psbdp->x;
-  double *xear = pedp->x;
   const double *ep;
   double Gmsm, dzmin;
   double rxy, rxyz, fac, sgn;
   double sinnode, cosnode, sinincl, cosincl, sinu, cosu, sinE, cosE, cosE2;
   double uu, ny, ny2, c2, v2, pp, ro, ro2, rn, rn2;
-  struct epsilon *oe;
-  AS_BOOL is_true_nodaps = FALSE;
-  AS_BOOL do_aberr = !(iflag & (SEFLG_TRUEPOS | SEFLG_NOABERR));
-  AS_BOOL do_defl = !(iflag & SEFLG_TRUEPOS) && !(iflag & SEFLG_NOGDEFL);
   AS_BOOL do_focal_point = method & SE_NODBIT_FOPOINT;
-  AS_BOOL ellipse_is_bary = FALSE;
   int32 iflg0;
-  iflag &= ~(SEFLG_JPLHOR | SEFLG_JPLHOR_APPROX);
-  /* function calls for Pluto with asteroid number 134340
-   * are treated as calls for Pluto as main body SE_PLUTO */
-  if (ipl == SE_AST_OFFSET + 134340)
-    ipl = SE_PLUTO;
   xna = xx; 
   xnd = xx+6; 
   xpe = xx+12; 
   xap = xx+18;
   xpos[0][0] = 0; /* to shut up mint */
-  /* to get control over the save area: */
-  swi_force_app_pos_etc();
+  *is_true_nodaps = FALSE;
+  *ellipse_is_bary = FALSE;
   method %= SE_NODBIT_FOPOINT;
   ipli = ipl;
   if (ipl == SE_SUN) 
     ipli = SE_EARTH;
-  if (ipl == SE_MOON) {
-    do_defl = FALSE;
-    if (!(iflag & SEFLG_HELCTR))
-      do_aberr = FALSE;
-  }
   iflg0 = (iflag & (SEFLG_EPHMASK|SEFLG_NONUT)) | SEFLG_SPEED | SEFLG_TRUEPOS;
   if (ipli != SE_MOON)
     iflg0 |= SEFLG_HELCTR;
-  if (ipl == SE_MEAN_NODE || ipl == SE_TRUE_NODE || 
-	  ipl == SE_MEAN_APOG || ipl == SE_OSCU_APOG || 
-	  ipl < 0 || 
-	  (ipl >= SE_NPLANETS && ipl <= SE_AST_OFFSET)) {
-	  /*(ipl >= SE_FICT_OFFSET && ipl - SE_FICT_OFFSET < SE_NFICT_ELEM)) */
-    if (serr != NULL)
-      sprintf(serr, "nodes/apsides for planet %5.0f are not implemented", (double) ipl);
-    if (xnasc != NULL)
-      for (i = 0; i <= 5; i++)
-	xnasc[i] = 0;
-    if (xndsc != NULL)
-      for (i = 0; i <= 5; i++)
-	xndsc[i] = 0;
-    if (xaphe != NULL)
-      for (i = 0; i <= 5; i++)
-	xaphe[i] = 0;
-    if (xperi != NULL)
-      for (i = 0; i <= 5; i++)
-	xperi[i] = 0;
-    return ERR;
-  }
   for (i = 0; i < 24; i++)
     xx[i] = 0;
   /***************************************
@@ -4871,15 +5071,26 @@ int32 swe_nod_aps(double tjd_et, int32 ipl, int32 iflag,
    * "true" or osculating nodes and apsides 
    ***************************************/
   } else {
+    *is_true_nodaps = TRUE;
     /* first, we need a heliocentric distance of the planet */
-    if (swe_calc(tjd_et, ipli, iflg0, x, serr) == ERR)
-      return ERR;
+    if (osc != NULL && osc->ipli == ipli && osc->dist_iflag == iflg0) {
+      x[2] = osc->dist;
+    } else {
+      if (swe_calc(tjd_et, ipli, iflg0, x, serr) == ERR)
+        return ERR;
+      if (osc != NULL) {
+        osc->ipli = ipli;
+        osc->dist_iflag = iflg0;
+        osc->dist = x[2];
+        osc->iflJ2000 = 0;
+      }
+    }
     iflJ2000 = (iflag & SEFLG_EPHMASK)|SEFLG_J2000|SEFLG_EQUATORIAL|SEFLG_XYZ|SEFLG_TRUEPOS|SEFLG_NONUT|SEFLG_SPEED;
-    ellipse_is_bary = FALSE;
+    *ellipse_is_bary = FALSE;
     if (ipli != SE_MOON) {
       if ((method & SE_NODBIT_OSCU_BAR) && x[2] > 6) {
         iflJ2000 |= SEFLG_BARYCTR; /* only planets beyond Jupiter */
-        ellipse_is_bary = TRUE;
+        *ellipse_is_bary = TRUE;
       } else {
         iflJ2000 |= SEFLG_HELCTR;
       }
@@ -4907,19 +5118,33 @@ int32 swe_nod_aps(double tjd_et, int32 ipl, int32 iflag,
       istart = iend = 0;
       dt = 0;
     }
-    for (i = istart, t = tjd_et - dt; i <= iend; i++, t += dt) {
-      if (istart == iend)
-        t = tjd_et;
-      if (swe_calc(t, ipli, iflJ2000, xpos[i], serr) == ERR)
-        return ERR;
-      /* the EMB is used instead of the earth */
-      if (ipli == SE_EARTH) {
-        if (swe_calc(t, SE_MOON, iflJ2000 & ~(SEFLG_BARYCTR|SEFLG_HELCTR), xposm, serr) == ERR)
+    /* the other methods of swe_nod_aps_batch() may have computed the 
+     * same positions */
+    if (osc != NULL && osc->ipli == ipli && osc->iflJ2000 == iflJ2000) {
+      for (i = istart; i <= iend; i++)
+        for (j = 0; j <= 5; j++)
+          xpos[i][j] = osc->xpos[i][j];
+    } else {
+      for (i = istart, t = tjd_et - dt; i <= iend; i++, t += dt) {
+        if (istart == iend)
+          t = tjd_et;
+        if (swe_calc(t, ipli, iflJ2000, xpos[i], serr) == ERR)
           return ERR;
-        for (j = 0; j <= 2; j++)
-          xpos[i][j] += xposm[j] / (EARTH_MOON_MRAT + 1.0);
+        /* the EMB is used instead of the earth */
+        if (ipli == SE_EARTH) {
+          if (swe_calc(t, SE_MOON, iflJ2000 & ~(SEFLG_BARYCTR|SEFLG_HELCTR), xposm, serr) == ERR)
+            return ERR;
+          for (j = 0; j <= 2; j++)
+            xpos[i][j] += xposm[j] / (EARTH_MOON_MRAT + 1.0);
+        }
+        swi_plan_for_osc_elem(iflg0, t, xpos[i]);
+      }
+      if (osc != NULL) {
+        osc->iflJ2000 = iflJ2000;
+        for (i = istart; i <= iend; i++)
+          for (j = 0; j <= 5; j++)
+            osc->xpos[i][j] = xpos[i][j];
       }
-      swi_plan_for_osc_elem(iflg0, t, xpos[i]);
     }
     for (i = istart; i <= iend; i++) {
       if (fabs(xpos[i][5]) < dzmin)
@@ -5020,19 +5245,44 @@ int32 swe_nod_aps(double tjd_et, int32 ipl, int32 iflag,
         xnd[i+3] = 0;
       }
     }
-    is_true_nodaps = TRUE;
   }
-  /* to set the variables required in the save area,
-   * i.e. ecliptic, nutation, barycentric sun, earth
-   * we compute the planet */
-  if (ipli == SE_MOON && (iflag & (SEFLG_HELCTR | SEFLG_BARYCTR))) {
-    swi_force_app_pos_etc();
-    if (swe_calc(tjd_et, SE_SUN, iflg0, x, serr) == ERR)
-      return ERR;
-  } else {
-    if (swe_calc(tjd_et, ipli, iflg0 | (iflag & SEFLG_TOPOCTR), x, serr) == ERR)
-      return ERR;
+  return OK;
+}
+
+/* converts the output of nod_aps_orbit() to the coordinates that iflag 
+ * asks for. The save area must hold the sun and earth of tjd_et. 
+ * ep, if not NULL, has samples of them for the apparent speed. */
+static int32 nod_aps_apparent(double tjd_et, int32 ipl, int32 iflag, 
+                      double *xx, AS_BOOL is_true_nodaps, 
+                      AS_BOOL ellipse_is_bary, struct nod_aps_epoch *ep,
+                      char *serr)
+{
+  int ij, i, j;
+  int32 ipli;
+  double daya;
+  double x2000[6], xobs[6], *xp;
+  double xobs2[6], x2[6], xear2[6], xsun2[6];
+  double dt;
+  struct plan_data *pedp = &swed.pldat[SEI_EARTH];
+  struct plan_data *psbdp = &swed.pldat[SEI_SUNBARY];
+  struct plan_data pldat;
+  double *xsun = psbdp->x;
+  double *xear = pedp->x;
+  struct epsilon *oe;
+  AS_BOOL do_aberr = !(iflag & (SEFLG_TRUEPOS | SEFLG_NOABERR));
+  AS_BOOL do_defl = !(iflag & SEFLG_TRUEPOS) && !(iflag & SEFLG_NOGDEFL);
+  int32 iflg0;
+  ipli = ipl;
+  if (ipl == SE_SUN) 
+    ipli = SE_EARTH;
+  if (ipl == SE_MOON) {
+    do_defl = FALSE;
+    if (!(iflag & SEFLG_HELCTR))
+      do_aberr = FALSE;
   }
+  iflg0 = (iflag & (SEFLG_EPHMASK|SEFLG_NONUT)) | SEFLG_SPEED | SEFLG_TRUEPOS;
+  if (ipli != SE_MOON)
+    iflg0 |= SEFLG_HELCTR;
   /***********************
    * position of observer
    ***********************/
@@ -5133,40 +5383,60 @@ int32 swe_nod_aps(double tjd_et, int32 ipl, int32 iflag,
        * Neglecting this would result in an error of several 0.1"
        */
       if (iflag & SEFLG_SPEED) {
-        /* get barycentric sun and earth for t-dt into save area */
-        if (swe_calc(tjd_et - dt, ipli, iflg0 | (iflag & SEFLG_TOPOCTR), x2, serr) == ERR)
-          return ERR;
-        if (iflag & SEFLG_TOPOCTR) {
-          /* geocentric position of observer */
-          /* if (swi_get_observer(tjd_et - dt, iflag, FALSE, xobs, serr) != OK)
-            return ERR;*/
-          for (i = 0; i <= 5; i++)
-            xobs2[i] = swed.topd.xobs[i];
-        } else {
+        if (ep != NULL && ep->nsamp > 0 && dt <= (ep->nsamp - 1) * NOD_APS_STEP) {
+          /* earth and sun at t-dt from the samples of the epoch */
+          nod_aps_interpol(ep, dt, xear2, xsun2);
           for (i = 0; i <= 5; i++)
             xobs2[i] = 0;
+          /* the restoring call of swe_calc() below does not compute earth
+           * and sun for the heliocentric sun; they stay at t-dt for the 
+           * following points */
+          if (iflg0 & SEFLG_HELCTR) {
+            for (i = 0; i <= 5; i++) {
+              xear[i] = xear2[i];
+              xsun[i] = xsun2[i];
+            }
+          }
+        } else {
+          /* get barycentric sun and earth for t-dt into save area */
+          if (swe_calc(tjd_et - dt, ipli, iflg0 | (iflag & SEFLG_TOPOCTR), x2, serr) == ERR)
+            return ERR;
+          if (iflag & SEFLG_TOPOCTR) {
+            /* geocentric position of observer */
+            /* if (swi_get_observer(tjd_et - dt, iflag, FALSE, xobs, serr) != OK)
+              return ERR;*/
+            for (i = 0; i <= 5; i++)
+              xobs2[i] = swed.topd.xobs[i];
+          } else {
+            for (i = 0; i <= 5; i++)
+              xobs2[i] = 0;
+          }
+          for (i = 0; i <= 5; i++) {
+            xear2[i] = xear[i];
+            xsun2[i] = xsun[i];
+          }
+          /* The above call of swe_calc() has destroyed the
+           * parts of the save area 
+           * (i.e. bary sun, earth nutation matrix!). 
+           * to restore it:
+           */
+          if (swe_calc(tjd_et, SE_SUN, iflg0 | (iflag & SEFLG_TOPOCTR), x2, serr) == ERR)
+            return ERR;
         }
         if (iflag & (SEFLG_HELCTR | SEFLG_BARYCTR)) {
           if ((iflag & SEFLG_HELCTR) && !(iflag & SEFLG_MOSEPH))
             for (i = 0; i <= 5; i++)
-              xobs2[i] = xsun[i];
+              xobs2[i] = xsun2[i];
         } else if (ipl == SE_SUN && !(iflag & SEFLG_MOSEPH)) {
           for (i = 0; i <= 5; i++)
-            xobs2[i] = xsun[i];
+            xobs2[i] = xsun2[i];
         } else {
           /* barycentric position of observer */
           for (i = 0; i <= 5; i++)
-            xobs2[i] += xear[i];
+            xobs2[i] += xear2[i];
         }
         for (i = 3; i <= 5; i++) 
           xp[i] += xobs[i] - xobs2[i];
-        /* The above call of swe_calc() has destroyed the
-         * parts of the save area 
-         * (i.e. bary sun, earth nutation matrix!). 
-         * to restore it:
-         */
-        if (swe_calc(tjd_et, SE_SUN, iflg0 | (iflag & SEFLG_TOPOCTR), x2, serr) == ERR)
-          return ERR;
       }
     }
     /*********************
@@ -5261,6 +5531,75 @@ int32 swe_nod_aps(double tjd_et, int32 ipl, int32 iflag,
       continue;
     }
   }
+  return OK;
+}
+
+/* to set the variables required in the save area,
+ * i.e. ecliptic, nutation, barycentric sun, earth
+ * we compute the planet */
+static int32 nod_aps_save_area(double tjd_et, int32 ipl, int32 iflag, char *serr)
+{
+  int32 ipli = ipl;
+  double x[6];
+  int32 iflg0;
+  if (ipl == SE_SUN) 
+    ipli = SE_EARTH;
+  iflg0 = (iflag & (SEFLG_EPHMASK|SEFLG_NONUT)) | SEFLG_SPEED | SEFLG_TRUEPOS;
+  if (ipli != SE_MOON)
+    iflg0 |= SEFLG_HELCTR;
+  if (ipli == SE_MOON && (iflag & (SEFLG_HELCTR | SEFLG_BARYCTR))) {
+    swi_force_app_pos_etc();
+    if (swe_calc(tjd_et, SE_SUN, iflg0, x, serr) == ERR)
+      return ERR;
+  } else {
+    if (swe_calc(tjd_et, ipli, iflg0 | (iflag & SEFLG_TOPOCTR), x, serr) == ERR)
+      return ERR;
+  }
+  return OK;
+}
+
+int32 swe_nod_aps(double tjd_et, int32 ipl, int32 iflag, 
+                      int32  method,
+                      double *xnasc, double *xndsc, 
+                      double *xperi, double *xaphe, 
+                      char *serr)
+{
+  int i;
+  double xx[24];
+  double *xna, *xnd, *xpe, *xap;
+  AS_BOOL is_true_nodaps, ellipse_is_bary;
+  iflag &= ~(SEFLG_JPLHOR | SEFLG_JPLHOR_APPROX);
+  /* function calls for Pluto with asteroid number 134340
+   * are treated as calls for Pluto as main body SE_PLUTO */
+  if (ipl == SE_AST_OFFSET + 134340)
+    ipl = SE_PLUTO;
+  xna = xx; 
+  xnd = xx+6; 
+  xpe = xx+12; 
+  xap = xx+18;
+  /* to get control over the save area: */
+  swi_force_app_pos_etc();
+  if (nod_aps_check(ipl, serr) == ERR) {
+    if (xnasc != NULL)
+      for (i = 0; i <= 5; i++)
+	xnasc[i] = 0;
+    if (xndsc != NULL)
+      for (i = 0; i <= 5; i++)
+	xndsc[i] = 0;
+    if (xaphe != NULL)
+      for (i = 0; i <= 5; i++)
+	xaphe[i] = 0;
+    if (xperi != NULL)
+      for (i = 0; i <= 5; i++)
+	xperi[i] = 0;
+    return ERR;
+  }
+  if (nod_aps_orbit(tjd_et, ipl, iflag, method, xx, &is_true_nodaps, &ellipse_is_bary, NULL, serr) == ERR)
+    return ERR;
+  if (nod_aps_save_area(tjd_et, ipl, iflag, serr) == ERR)
+    return ERR;
+  if (nod_aps_apparent(tjd_et, ipl, iflag, xx, is_true_nodaps, ellipse_is_bary, NULL, serr) == ERR)
+    return ERR;
   for (i = 0; i <= 5; i++) {
     if (i > 2 && !(iflag & SEFLG_SPEED))
       xna[i] = xnd[i] = xpe[i] = xap[i] = 0;
@@ -5287,6 +5626,145 @@ int32 swe_nod_aps_ut(double tjd_ut, int32 ipl, int32 iflag,
                       serr);
 }
 
+static void nod_aps_batch_fail(double *xx, AS_BOOL *failed, char *serr2, int32 *retc, char *serr)
+{
+  int i;
+  for (i = 0; i < 24; i++)
+    xx[i] = 0;
+  *failed = TRUE;
+  if (*retc != ERR && serr != NULL)
+    strcpy(serr, serr2);
+  *retc = ERR;
+}
+
+/* nodes and apsides of nipl bodies with nmeth methods for one date.
+ * xret receives, for each body and, within it, for each method, 24 
+ * doubles: ascending node, descending node, perihelion, aphelion as 
+ * swe_nod_aps() returns them. The positions of a body are computed once
+ * for all of its osculating methods, and sun, earth and nutation once for
+ * all bodies. For the apparent speed, the earth and sun at the date minus
+ * the light-time of a point are interpolated from three samples half a day
+ * apart in all; the difference to swe_nod_aps() in speed is about 
+ * 2e-4"/day, at most 0.0013"/day.
+ * returns OK, or ERR if a body/method fails; its 24 doubles are zero
+ * then, the others are computed, and serr has the first error message.
+ * if sun and earth of the date fail, all of them are zero.
+ */
+int32 swe_nod_aps_batch(double tjd_et, int32 *ipl, int32 nipl, int32 iflag, 
+                      int32 *method, int32 nmeth, double *xret, char *serr)
+{
+  int i, j, k, ij;
+  int32 iplk, retc = OK;
+  double x[6], *xx;
+  int32 iflg0;
+  AS_BOOL *is_true_nodaps, *ellipse_is_bary, *failed;
+  AS_BOOL do_aberr_speed;
+  char serr2[AS_MAXCH];
+  struct nod_aps_osc osc;
+  struct nod_aps_epoch ep;
+  if (nipl <= 0 || nmeth <= 0)
+    return OK;
+  iflag &= ~(SEFLG_JPLHOR | SEFLG_JPLHOR_APPROX);
+  if ((is_true_nodaps = (AS_BOOL *) calloc((size_t) (3 * nipl * nmeth), sizeof(AS_BOOL))) == NULL) {
+    if (serr != NULL)
+      strcpy(serr, "error in malloc() in swe_nod_aps_batch()");
+    return ERR;
+  }
+  ellipse_is_bary = is_true_nodaps + nipl * nmeth;
+  failed = ellipse_is_bary + nipl * nmeth;
+  if (serr != NULL)
+    *serr = '\0';
+  /* to get control over the save area: */
+  swi_force_app_pos_etc();
+  for (i = 0; i < nipl; i++) {
+    iplk = ipl[i];
+    if (iplk == SE_AST_OFFSET + 134340)
+      iplk = SE_PLUTO;
+    osc.ipli = -1;
+    for (j = 0; j < nmeth; j++) {
+      k = i * nmeth + j;
+      if (nod_aps_check(iplk, serr2) == ERR
+        || nod_aps_orbit(tjd_et, iplk, iflag, method[j], xret + 24 * k, &is_true_nodaps[k], &ellipse_is_bary[k], &osc, serr2) == ERR) {
+        nod_aps_batch_fail(xret + 24 * k, &failed[k], serr2, &retc, serr);
+      }
+    }
+  }
+  /* sun, earth and nutation of the date into the save area */
+  iflg0 = (iflag & (SEFLG_EPHMASK|SEFLG_NONUT)) | SEFLG_SPEED | SEFLG_TRUEPOS;
+  ep.nsamp = 0;
+  do_aberr_speed = (iflag & SEFLG_SPEED) && !(iflag & (SEFLG_TRUEPOS | SEFLG_NOABERR));
+  if (do_aberr_speed && !(iflag & SEFLG_TOPOCTR)) {
+    for (i = NOD_APS_NSAMP - 1; i >= 1; i--) {
+      if (swe_calc(tjd_et - i * NOD_APS_STEP, SE_SUN, iflg0, x, serr2) == ERR)
+        goto fail_nod_aps_batch;
+      for (j = 0; j <= 5; j++) {
+        ep.xear[i][j] = swed.pldat[SEI_EARTH].x[j];
+        ep.xsun[i][j] = swed.pldat[SEI_SUNBARY].x[j];
+      }
+    }
+    ep.nsamp = NOD_APS_NSAMP;
+  }
+  swi_force_app_pos_etc();
+  if (swe_calc(tjd_et, SE_SUN, iflg0 | (iflag & SEFLG_TOPOCTR), x, serr2) == ERR)
+    goto fail_nod_aps_batch;
+  for (j = 0; j <= 5; j++) {
+    ep.xear[0][j] = swed.pldat[SEI_EARTH].x[j];
+    ep.xsun[0][j] = swed.pldat[SEI_SUNBARY].x[j];
+  }
+  for (i = 0; i < nipl; i++) {
+    iplk = ipl[i];
+    if (iplk == SE_AST_OFFSET + 134340)
+      iplk = SE_PLUTO;
+    for (j = 0; j < nmeth; j++) {
+      k = i * nmeth + j;
+      xx = xret + 24 * k;
+      if (failed[k])
+        continue;
+      if (ep.nsamp > 0) {
+        /* the previous body may have left the save area at t-dt */
+        for (ij = 0; ij <= 5; ij++) {
+          swed.pldat[SEI_EARTH].x[ij] = ep.xear[0][ij];
+          swed.pldat[SEI_SUNBARY].x[ij] = ep.xsun[0][ij];
+        }
+      } else if (do_aberr_speed) {
+        /* topocentric: nod_aps_apparent() calls swe_calc() for t-dt,
+         * set up the save area as swe_nod_aps() does */
+        swi_force_app_pos_etc();
+        if (nod_aps_save_area(tjd_et, iplk, iflag, serr2) == ERR) {
+          nod_aps_batch_fail(xx, &failed[k], serr2, &retc, serr);
+          continue;
+        }
+      }
+      if (nod_aps_apparent(tjd_et, iplk, iflag, xx, is_true_nodaps[k], ellipse_is_bary[k], &ep, serr2) == ERR) {
+        nod_aps_batch_fail(xx, &failed[k], serr2, &retc, serr);
+        continue;
+      }
+      if (!(iflag & SEFLG_SPEED))
+        for (ij = 0; ij < 4; ij++)
+          xx[6 * ij + 3] = xx[6 * ij + 4] = xx[6 * ij + 5] = 0;
+    }
+  }
+  goto end_nod_aps_batch;
+fail_nod_aps_batch:
+  /* the entries still hold their heliocentric orbits */
+  for (k = 0; k < nipl * nmeth; k++)
+    nod_aps_batch_fail(xret + 24 * k, &failed[k], serr2, &retc, serr);
+end_nod_aps_batch:
+  /* the save area may hold earth and sun of t-dt with the date of tjd_et */
+  swi_force_app_pos_etc();
+  swed.pldat[SEI_EARTH].teval = 0;
+  swed.pldat[SEI_SUNBARY].teval = 0;
+  free(is_true_nodaps);
+  return retc;
+}
+
+int32 swe_nod_aps_batch_ut(double tjd_ut, int32 *ipl, int32 nipl, int32 iflag, 
+                      int32 *method, int32 nmeth, double *xret, char *serr)
+{
+  return swe_nod_aps_batch(tjd_ut + swe_deltat_ex(tjd_ut, iflag, serr),
+                      ipl, nipl, iflag, method, nmeth, xret, serr);
+}
+
 /* function finds the gauquelin sector position of a planet or fixed star
  * 
  * if starname != NULL then a star is computed.
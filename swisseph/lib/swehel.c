@@ -385,6 +385,198 @@ int32 call_swe_rise_trans(double tjd, int32 ipl, char *star, int32 helflag, int3
   return retval;
 }
 
+/* 
+ * Memoization of positions, rise/set times and magnitudes during one 
+ * heliacal search. The searches evaluate the same objects at the same
+ * instants over and over again (ObjectLoc() for altitude, azimuth and 
+ * declination, the arcus visionis loops, the day-by-day rise/set scan).
+ * Entries are keyed on all arguments that influence the result, so a hit
+ * returns exactly what a new call would return. The tables are cleared 
+ * when the outermost public heliacal function is entered; nested calls 
+ * (e.g. swe_vis_limit_mag() from swe_heliacal_ut()) keep them.
+ * Results with an error or a warning in serr are not stored.
+ */
+#define HEL_CACHE_NPOS	32
+#define HEL_CACHE_NRISE	16
+#define HEL_CACHE_NMAG	16
+#define HEL_CACHE_NHOR	8
+struct hel_pos_save {
+  double tjd;
+  int32 ipl;	/* -1 for the fixed star hel_cache.star */
+  int32 iflag;
+  double topo[3];
+  double x[6];
+  int32 retval;
+};
+struct hel_rise_save {
+  double tjd;
+  int32 ipl;
+  int32 eventtype, helflag;
+  double dgeo[3], atpress, attemp;
+  double tret;
+  int32 retc;
+};
+struct hel_hor_save {
+  double tjd;
+  double xin[2];
+  double dgeo[3], atpress, attemp;
+  double xaz[3];
+};
+struct hel_mag_save {
+  double tjd;
+  int32 ipl, helflag;
+  double dgeo[3];
+  double dmag;
+};
+static TLS struct {
+  int depth;
+  char star[AS_MAXCH];
+  int npos, nrise, nhor, nmag;	/* number of valid entries */
+  int ipos, irise, ihor, imag;	/* next slot to be overwritten */
+  struct hel_pos_save pos[HEL_CACHE_NPOS];
+  struct hel_rise_save rise[HEL_CACHE_NRISE];
+  struct hel_hor_save hor[HEL_CACHE_NHOR];
+  struct hel_mag_save mag[HEL_CACHE_NMAG];
+} hel_cache;
+
+static void hel_cache_clear(void)
+{
+  hel_cache.npos = hel_cache.nrise = hel_cache.nhor = hel_cache.nmag = 0;
+  hel_cache.ipos = hel_cache.irise = hel_cache.ihor = hel_cache.imag = 0;
+  *hel_cache.star = '\0';
+}
+
+static void hel_cache_open(void)
+{
+  if (hel_cache.depth++ == 0)
+    hel_cache_clear();
+}
+
+static void hel_cache_close(void)
+{
+  if (hel_cache.depth > 0)
+    hel_cache.depth--;
+}
+
+/* Lets a batch of heliacal calculations share the tables, e.g. many stars
+ * for the same location, so that Sun and Moon are not recomputed for 
+ * every object. Calls must be paired, swi_heliacal_cache_close() ends 
+ * the batch. */
+void swi_heliacal_cache_open(void)
+{
+  hel_cache_open();
+}
+
+void swi_heliacal_cache_close(void)
+{
+  hel_cache_close();
+}
+
+static void hel_cache_set_star(char *star)
+{
+  int i;
+  if (strcmp(star, hel_cache.star) != 0) {
+    /* entries with ipl == -1 belong to the previous star; 
+     * -2 never matches */
+    for (i = 0; i < hel_cache.npos; i++) {
+      if (hel_cache.pos[i].ipl == -1)
+	hel_cache.pos[i].ipl = -2;
+    }
+    for (i = 0; i < hel_cache.nrise; i++) {
+      if (hel_cache.rise[i].ipl == -1)
+	hel_cache.rise[i].ipl = -2;
+    }
+    strcpy(hel_cache.star, star);
+  }
+}
+
+/* position of planet ipl or, if ipl == -1, of the fixed star star */
+static int32 hel_calc(double tjd, int32 ipl, char *star, int32 iflag, double *x, char *serr)
+{
+  int32 retval, i;
+  char s[AS_MAXCH];
+  struct hel_pos_save *p;
+  AS_BOOL topo = (iflag & SEFLG_TOPOCTR) != 0;
+  if (hel_cache.depth == 0) {
+    if (ipl == -1)
+      return call_swe_fixstar(star, tjd, iflag, x, serr);
+    return swe_calc(tjd, ipl, iflag, x, serr);
+  }
+  if (ipl == -1)
+    hel_cache_set_star(star);
+  for (i = 0; i < hel_cache.npos; i++) {
+    p = &hel_cache.pos[i];
+    if (p->tjd == tjd && p->ipl == ipl && p->iflag == iflag
+      && (!topo || (p->topo[0] == swed.topd.geolon 
+                 && p->topo[1] == swed.topd.geolat 
+		 && p->topo[2] == swed.topd.geoalt))) {
+      for (i = 0; i < 6; i++)
+	x[i] = p->x[i];
+      return p->retval;
+    }
+  }
+  *s = '\0';
+  if (ipl == -1)
+    retval = call_swe_fixstar(star, tjd, iflag, x, s);
+  else
+    retval = swe_calc(tjd, ipl, iflag, x, s);
+  if (*s != '\0') {
+    if (serr != NULL)
+      strcpy(serr, s);
+    return retval;
+  }
+  if (retval == ERR)
+    return retval;
+  p = &hel_cache.pos[hel_cache.ipos];
+  p->tjd = tjd;
+  p->ipl = ipl;
+  p->iflag = iflag;
+  p->topo[0] = swed.topd.geolon;
+  p->topo[1] = swed.topd.geolat;
+  p->topo[2] = swed.topd.geoalt;
+  for (i = 0; i < 6; i++)
+    p->x[i] = x[i];
+  p->retval = retval;
+  hel_cache.ipos = (hel_cache.ipos + 1) % HEL_CACHE_NPOS;
+  if (hel_cache.npos < HEL_CACHE_NPOS)
+    hel_cache.npos++;
+  return retval;
+}
+
+/* swe_azalt(SE_EQU2HOR); ObjectLoc() asks for altitude and azimuth 
+ * of the same position one after the other */
+static void hel_azalt(double tjd_ut, double *dgeo, double atpress, double attemp, double *xin, double *xaz)
+{
+  int i;
+  struct hel_hor_save *p;
+  for (i = 0; i < hel_cache.nhor && hel_cache.depth > 0; i++) {
+    p = &hel_cache.hor[i];
+    if (p->tjd == tjd_ut && p->xin[0] == xin[0] && p->xin[1] == xin[1]
+      && p->dgeo[0] == dgeo[0] && p->dgeo[1] == dgeo[1] && p->dgeo[2] == dgeo[2]
+      && p->atpress == atpress && p->attemp == attemp) {
+      for (i = 0; i < 3; i++)
+	xaz[i] = p->xaz[i];
+      return;
+    }
+  }
+  swe_azalt(tjd_ut, SE_EQU2HOR, dgeo, atpress, attemp, xin, xaz);
+  if (hel_cache.depth == 0)
+    return;
+  p = &hel_cache.hor[hel_cache.ihor];
+  p->tjd = tjd_ut;
+  p->xin[0] = xin[0];
+  p->xin[1] = xin[1];
+  for (i = 0; i < 3; i++) {
+    p->dgeo[i] = dgeo[i];
+    p->xaz[i] = xaz[i];
+  }
+  p->atpress = atpress;
+  p->attemp = attemp;
+  hel_cache.ihor = (hel_cache.ihor + 1) % HEL_CACHE_NHOR;
+  if (hel_cache.nhor < HEL_CACHE_NHOR)
+    hel_cache.nhor++;
+}
+
 /* 
  * Written by Dieter Koch:
  * Fast function for risings and settings of planets, can be used instead of 
@@ -483,18 +675,54 @@ else
 
 static int32 my_rise_trans(double tjd, int32 ipl, char* starname, int32 eventtype, int32 helflag, double *dgeo, double *datm, double *tret, char *serr)
 {
-  int retc = OK;
+  int retc = OK, i;
+  char s[AS_MAXCH];
+  struct hel_rise_save *p;
   if (starname != NULL && *starname != '\0')
     ipl = DeterObject(starname);
+  if (hel_cache.depth > 0) {
+    if (ipl == -1)
+      hel_cache_set_star(starname);
+    for (i = 0; i < hel_cache.nrise; i++) {
+      p = &hel_cache.rise[i];
+      if (p->tjd == tjd && p->ipl == ipl && p->eventtype == eventtype 
+	&& p->helflag == helflag && p->dgeo[0] == dgeo[0] 
+	&& p->dgeo[1] == dgeo[1] && p->dgeo[2] == dgeo[2]
+	&& p->atpress == datm[0] && p->attemp == datm[1]) {
+	*tret = p->tret;
+	return p->retc;
+      }
+    }
+  }
+  *s = '\0';
   /* for non-circumpolar planets we can use a faster algorithm */
   /*if (!(helflag & SE_HELFLAG_HIGH_PRECISION) && ipl != -1 && fabs(dgeo[1]) < 58) {*/
   if (ipl != -1 && fabs(dgeo[1]) < 63) {
-    retc = calc_rise_and_set(tjd, ipl, dgeo, datm, eventtype, helflag, tret, serr);
+    retc = calc_rise_and_set(tjd, ipl, dgeo, datm, eventtype, helflag, tret, s);
   /* for stars and circumpolar planets we use a rigorous algorithm */
   } else {
-    retc = call_swe_rise_trans(tjd, ipl, starname, helflag, eventtype, dgeo, datm[0], datm[1], tret, serr);
+    retc = call_swe_rise_trans(tjd, ipl, starname, helflag, eventtype, dgeo, datm[0], datm[1], tret, s);
   }
 /*  printf("%f, %f\n", tjd, *tret);*/
+  if (*s != '\0') {
+    if (serr != NULL)
+      strcpy(serr, s);
+  } else if (retc != ERR && hel_cache.depth > 0) {
+    p = &hel_cache.rise[hel_cache.irise];
+    p->tjd = tjd;
+    p->ipl = ipl;
+    p->eventtype = eventtype;
+    p->helflag = helflag;
+    for (i = 0; i < 3; i++)
+      p->dgeo[i] = dgeo[i];
+    p->atpress = datm[0];
+    p->attemp = datm[1];
+    p->tret = *tret;
+    p->retc = retc;
+    hel_cache.irise = (hel_cache.irise + 1) % HEL_CACHE_NRISE;
+    if (hel_cache.nrise < HEL_CACHE_NRISE)
+      hel_cache.nrise++;
+  }
   return retc;
 }
 
@@ -542,7 +770,7 @@ static double SunRA(double JDNDaysUT, int32 helflag, char *serr)
     int32 iflag = epheflag | SEFLG_EQUATORIAL;
     iflag |= SEFLG_NONUT | SEFLG_TRUEPOS;
     tjd_tt = JDNDaysUT + swe_deltat_ex(JDNDaysUT, epheflag, serr);
-    if (swe_calc(tjd_tt, SE_SUN, iflag, x, serr) != ERR) {
+    if (hel_calc(tjd_tt, SE_SUN, "", iflag, x, serr) != ERR) {
       ralast = x[0];
       tjdlast = JDNDaysUT;
       return ralast;
@@ -668,13 +896,8 @@ static int32 ObjectLoc(double JDNDaysUT, double *dgeo, double *datm, char *Objec
   if (Angle == 7) Angle = 0;
   tjd_tt = JDNDaysUT + swe_deltat_ex(JDNDaysUT, epheflag, serr);
   Planet = DeterObject(ObjectName);
-  if (Planet != -1) {
-    if (swe_calc(tjd_tt, Planet, iflag, x, serr) == ERR)
-      return ERR;
-  } else {
-    if (call_swe_fixstar(ObjectName, tjd_tt, iflag, x, serr) == ERR)
-      return ERR;
-  }
+  if (hel_calc(tjd_tt, Planet, ObjectName, iflag, x, serr) == ERR)
+    return ERR;
   if (Angle == 2 ||  Angle == 5) {
     *dret = x[1];
   } else {
@@ -683,7 +906,7 @@ static int32 ObjectLoc(double JDNDaysUT, double *dgeo, double *datm, char *Objec
     } else {
       xin[0] = x[0];
       xin[1] = x[1];
-      swe_azalt(JDNDaysUT, SE_EQU2HOR, dgeo, datm[0], datm[1], xin, xaz);
+      hel_azalt(JDNDaysUT, dgeo, datm[0], datm[1], xin, xaz);
       if (Angle == 0)
 	*dret = xaz[1];
       if (Angle == 4)
@@ -721,16 +944,11 @@ static int32 azalt_cart(double JDNDaysUT, double *dgeo, double *datm, char *Obje
   iflag = iflag | SEFLG_TOPOCTR;
   tjd_tt = JDNDaysUT + swe_deltat_ex(JDNDaysUT, epheflag, serr);
   Planet = DeterObject(ObjectName);
-  if (Planet != -1) {
-    if (swe_calc(tjd_tt, Planet, iflag, x, serr) == ERR)
-      return ERR;
-  } else {
-    if (call_swe_fixstar(ObjectName, tjd_tt, iflag, x, serr) == ERR)
-      return ERR;
-  }
+  if (hel_calc(tjd_tt, Planet, ObjectName, iflag, x, serr) == ERR)
+    return ERR;
   xin[0] = x[0];
   xin[1] = x[1];
-  swe_azalt(JDNDaysUT, SE_EQU2HOR, dgeo, datm[0], datm[1], xin, xaz);
+  hel_azalt(JDNDaysUT, dgeo, datm[0], datm[1], xin, xaz);
   dret[0] = xaz[0];
   dret[1] = xaz[1]; /* true altitude */
   dret[2] = xaz[2]; /* apparent altitude */
@@ -1070,7 +1288,9 @@ static double Bn(double AltO, double JDNDayUT, double AltS, double sunra, double
 static int32 Magnitude(double JDNDaysUT, double *dgeo, char *ObjectName, int32 helflag, double *dmag, char *serr)
 {
   double x[20];
-  int32 Planet, iflag, epheflag;
+  int32 Planet, iflag, epheflag, i;
+  char s[AS_MAXCH];
+  struct hel_mag_save *p;
   epheflag = helflag & (SEFLG_JPLEPH|SEFLG_SWIEPH|SEFLG_MOSEPH);
   *dmag = -99.0;
   Planet = DeterObject(ObjectName);
@@ -1079,10 +1299,37 @@ static int32 Magnitude(double JDNDaysUT, double *dgeo, char *ObjectName, int32 h
     iflag |= SEFLG_NONUT|SEFLG_TRUEPOS;
   if (Planet != -1) {
     /**dmag = Phenomena(JDNDaysUT, Lat, Longitude, HeightEye, TempE, PresE, ObjectName, 4);*/
+    for (i = 0; i < hel_cache.nmag && hel_cache.depth > 0; i++) {
+      p = &hel_cache.mag[i];
+      if (p->tjd == JDNDaysUT && p->ipl == Planet && p->helflag == helflag 
+	&& p->dgeo[0] == dgeo[0] && p->dgeo[1] == dgeo[1] && p->dgeo[2] == dgeo[2]) {
+	*dmag = p->dmag;
+	return OK;
+      }
+    }
     swe_set_topo(dgeo[0], dgeo[1], dgeo[2]);
-    if (swe_pheno_ut(JDNDaysUT, Planet, iflag, x, serr) == ERR)
+    *s = '\0';
+    if (swe_pheno_ut(JDNDaysUT, Planet, iflag, x, s) == ERR) {
+      if (serr != NULL)
+	strcpy(serr, s);
       return ERR;
+    }
     *dmag = x[4];
+    if (*s != '\0') {
+      if (serr != NULL)
+	strcpy(serr, s);
+    } else if (hel_cache.depth > 0) {
+      p = &hel_cache.mag[hel_cache.imag];
+      p->tjd = JDNDaysUT;
+      p->ipl = Planet;
+      p->helflag = helflag;
+      for (i = 0; i < 3; i++)
+	p->dgeo[i] = dgeo[i];
+      p->dmag = *dmag;
+      hel_cache.imag = (hel_cache.imag + 1) % HEL_CACHE_NMAG;
+      if (hel_cache.nmag < HEL_CACHE_NMAG)
+	hel_cache.nmag++;
+    }
   } else {
     if (call_swe_fixstar_mag(ObjectName, dmag, serr) == ERR)
       return ERR;
@@ -1320,15 +1567,24 @@ static void default_heliacal_parameters(double *datm, double *dgeo, double *dobs
 ' VR [km]
 ' VisLimMagn [-]
 */
+static double VisLimMagnBsk(double *dobs, double Bsk, double kX, double JDNDaysUT, int32 helflag, int32 *scotopic_flag);
+
 static double VisLimMagn(double *dobs, double AltO, double AziO, double AltM, double AziM, double JDNDaysUT, double AltS, double AziS, double sunra, double Lat, double HeightEye, double *datm, int32 helflag, int32 *scotopic_flag, char *serr)
 {
-  double C1, C2, Th, kX, Bsk, CorrFactor1, CorrFactor2;
-  double log10 = 2.302585092994;
+  double kX, Bsk;
   /*double Age = dobs[0];*/
   /*double SN = dobs[1];*/
   Bsk = Bsky(AltO, AziO, AltM, AziM, JDNDaysUT, AltS, AziS, sunra, Lat, HeightEye, datm, helflag, serr);
   /* Schaefer, Astronomy and the limits of vision, Archaeoastronomy, 1993 Verder:*/
   kX = Deltam(AltO, AltS, sunra, Lat, HeightEye, datm, helflag, serr);
+  return VisLimMagnBsk(dobs, Bsk, kX, JDNDaysUT, helflag, scotopic_flag);
+}
+
+/* limiting magnitude for sky brightness Bsk [nL] and extinction kX [mag] */
+static double VisLimMagnBsk(double *dobs, double Bsk, double kX, double JDNDaysUT, int32 helflag, int32 *scotopic_flag)
+{
+  double C1, C2, Th, CorrFactor1, CorrFactor2;
+  double log10 = 2.302585092994;
   /* influence of age*/
   /*Fa = mymax(1, pow(p(23, Bsk) / p(Age, Bsk), 2)); */
   CorrFactor1 = OpticFactor(Bsk, kX, dobs, JDNDaysUT, "", 1, helflag);
@@ -1376,7 +1632,7 @@ static double VisLimMagn(double *dobs, double AltO, double AziO, double AltM, do
  *  |1  OK, scotopic vision
  *  |2  OK, near limit photopic/scotopic
 */
-int32 swe_vis_limit_mag(double tjdut, double *dgeo, double *datm, double *dobs, char *ObjectName, int32 helflag, double *dret, char *serr)
+static int32 vis_limit_mag(double tjdut, double *dgeo, double *datm, double *dobs, char *ObjectName, int32 helflag, double *dret, char *serr)
 {
   int32 retval = OK, i, scotopic_flag = 0;
   double AltO, AziO, AltM, AziM, AltS, AziS;
@@ -1454,6 +1710,91 @@ int32 swe_vis_limit_mag(double tjdut, double *dgeo, double *datm, double *dobs,
   return retval;
 }
 
+int32 swe_vis_limit_mag(double tjdut, double *dgeo, double *datm, double *dobs, char *ObjectName, int32 helflag, double *dret, char *serr)
+{
+  int32 retval;
+  hel_cache_open();
+  retval = vis_limit_mag(tjdut, dgeo, datm, dobs, ObjectName, helflag, dret, serr);
+  hel_cache_close();
+  return retval;
+}
+
+static int32 vis_limit_mag_grid(double tjdut, double *dgeo, double *datm, double *dobs, int32 helflag, int32 npoints, double *dazialt, double *dret, char *serr)
+{
+  int32 i, scotopic_flag = 0;
+  double AltO, AziO, AltM, AziM, AltS, AziS, AppAltO;
+  double sunra, PresE, TempE, Bsk, kX, *d;
+  swi_set_tid_acc(tjdut, helflag, 0, serr);
+  sunra = SunRA(tjdut, helflag, serr);
+  default_heliacal_parameters(datm, dgeo, dobs, helflag);
+  swe_set_topo(dgeo[0], dgeo[1], dgeo[2]);
+  if (helflag & SE_HELFLAG_VISLIM_DARK) {
+    AltS = -90;
+    AziS = 0;
+  } else {
+    if (ObjectLoc(tjdut, dgeo, datm, "sun", 0, helflag, &AltS, serr) == ERR)
+      return ERR;
+    if (ObjectLoc(tjdut, dgeo, datm, "sun", 1, helflag, &AziS, serr) == ERR)
+      return ERR;
+  }
+  if ((helflag & SE_HELFLAG_VISLIM_DARK) || (helflag & SE_HELFLAG_VISLIM_NOMOON)) {
+    AltM = -90; AziM = 0;
+  } else {
+    if (ObjectLoc(tjdut, dgeo, datm, "moon", 0, helflag, &AltM, serr) == ERR)
+      return ERR;
+    if (ObjectLoc(tjdut, dgeo, datm, "moon", 1, helflag, &AziM, serr) == ERR)
+      return ERR;
+  }
+  /* as in Deltam() */
+  PresE = PresEfromPresS(datm[1], datm[0], dgeo[2]);
+  TempE = TempEfromTempS(datm[1], dgeo[2], LapseSA);
+  for (i = 0; i < npoints; i++) {
+    d = dret + i * SE_VISLIM_GRID_NVAL;
+    AziO = dazialt[2 * i];
+    AltO = dazialt[2 * i + 1];
+    if (AltO < 0) {
+      d[0] = -100;
+      d[1] = d[2] = d[3] = 0;
+      d[4] = -2;
+      continue;
+    }
+    Bsk = Bsky(AltO, AziO, AltM, AziM, tjdut, AltS, AziS, sunra, dgeo[1], dgeo[2], datm, helflag, serr);
+    kX = Deltam(AltO, AltS, sunra, dgeo[1], dgeo[2], datm, helflag, serr);
+    AppAltO = AppAltfromTopoAlt(AltO, TempE, PresE, helflag);
+    d[0] = VisLimMagnBsk(dobs, Bsk, kX, tjdut, helflag, &scotopic_flag);
+    d[1] = Bsk;
+    d[2] = kX;
+    d[3] = Airmass(AppAltO, datm[0]);
+    d[4] = scotopic_flag;
+  }
+  return OK;
+}
+
+/* Limiting magnitude for many points of the sky at one instant, e.g. a
+ * sky map on an alt/az grid. Sun, Moon and the twilight terms that depend 
+ * only on them are computed once for all points. Points with the same
+ * altitude should follow each other, the extinction is then reused.
+ * dazialt	npoints pairs of azimuth and altitude [deg], like dret[2] and
+ *		dret[1] of swe_vis_limit_mag(): azimuth from north over east,
+ *		true topocentric altitude
+ * dret		SE_VISLIM_GRID_NVAL values per point:
+ *		[0] limiting magnitude, -100 below the horizon
+ *		[1] sky brightness [nL]
+ *		[2] extinction [mag]
+ *		[3] airmass
+ *		[4] SE_PHOTOPIC_FLAG etc. as returned by swe_vis_limit_mag(),
+ *		    -2 below the horizon
+ * returns OK or ERR
+ */
+int32 swe_vis_limit_mag_grid(double tjdut, double *dgeo, double *datm, double *dobs, int32 helflag, int32 npoints, double *dazialt, double *dret, char *serr)
+{
+  int32 retval;
+  hel_cache_open();
+  retval = vis_limit_mag_grid(tjdut, dgeo, datm, dobs, helflag, npoints, dazialt, dret, serr);
+  hel_cache_close();
+  return retval;
+}
+
 /*###################################################################
 ' Magn [-]
 ' age [Year]
@@ -1768,7 +2109,7 @@ static void strcpy_VBsafe(char *sout, char *sin)
 '28=CVAact [deg] 'new
 '29=MSk [-]
 */
-int32 swe_heliacal_pheno_ut(double JDNDaysUT, double *dgeo, double *datm, double *dobs, char *ObjectNameIn, int32 TypeEvent, int32 helflag, double *darr, char *serr)
+static int32 heliacal_pheno_ut(double JDNDaysUT, double *dgeo, double *datm, double *dobs, char *ObjectNameIn, int32 TypeEvent, int32 helflag, double *darr, char *serr)
 {
   double AziS, AltS, AltS2, AziO, AltO, AltO2, GeoAltO, AppAltO, DAZact, TAVact, ParO, MagnO;
   double ARCVact, ARCLact, kact, WMoon, LMoon = 0, qYal, qCrit;
@@ -1981,6 +2322,15 @@ output_heliacal_pheno:
   return OK;
 }
 
+int32 swe_heliacal_pheno_ut(double JDNDaysUT, double *dgeo, double *datm, double *dobs, char *ObjectNameIn, int32 TypeEvent, int32 helflag, double *darr, char *serr)
+{
+  int32 retval;
+  hel_cache_open();
+  retval = heliacal_pheno_ut(JDNDaysUT, dgeo, datm, dobs, ObjectNameIn, TypeEvent, helflag, darr, serr);
+  hel_cache_close();
+  return retval;
+}
+
 #if 0
 int32 HeliacalJDut(double JDNDaysUTStart, double Age, double SN, double Lat, double Longitude, double HeightEye, double Temperature, double Pressure, double RH, double VR, char *ObjectName, int TypeEvent, char *AVkind, double *dret, char *serr)
 {
@@ -2203,7 +2553,7 @@ static int32 heliacal_ut_arc_vis(double JDNDaysUTStart, double *dgeo, double *da
 	  goto swe_heliacal_err;
 	/* determine time compensation to get Sun's altitude at heliacal rise */
 	tjd_tt = tret + swe_deltat_ex(tret, epheflag, serr);
-	if ((retval = swe_calc(tjd_tt, SE_SUN, iflag, x, serr)) == ERR)
+	if ((retval = hel_calc(tjd_tt, SE_SUN, "", iflag, x, serr)) == ERR)
 	  goto swe_heliacal_err;
 	xin[0] = x[0];
 	xin[1] = x[1];
@@ -2219,7 +2569,7 @@ static int32 heliacal_ut_arc_vis(double JDNDaysUTStart, double *dgeo, double *da
 	JDNarcvisUT = tret - Tdelta / 24;
 	tjd_tt = JDNarcvisUT + swe_deltat_ex(JDNarcvisUT, epheflag, serr);
 	/* determine Sun's position */
-	if ((retval = swe_calc(tjd_tt, SE_SUN, iflag, x, serr)) == ERR)
+	if ((retval = hel_calc(tjd_tt, SE_SUN, "", iflag, x, serr)) == ERR)
 	  goto swe_heliacal_err;
 	xin[0] = x[0];
 	xin[1] = x[1];
@@ -2230,7 +2580,7 @@ static int32 heliacal_ut_arc_vis(double JDNDaysUTStart, double *dgeo, double *da
 	/* determine Moon's position */
 #if 0
   double AltM, AziM;
-	if ((retval = swe_calc(tjd_tt, SE_MOON, iflag, x, serr)) == ERR)
+	if ((retval = hel_calc(tjd_tt, SE_MOON, "", iflag, x, serr)) == ERR)
 	  goto swe_heliacal_err;
 	xin[0] = x[0];
 	xin[1] = x[1];
@@ -2241,13 +2591,13 @@ static int32 heliacal_ut_arc_vis(double JDNDaysUTStart, double *dgeo, double *da
 #endif
 	/* determine object's position */
 	if (Planet != -1) {
-	  if ((retval = swe_calc(tjd_tt, Planet, iflag, x, serr)) == ERR)
+	  if ((retval = hel_calc(tjd_tt, Planet, ObjectName, iflag, x, serr)) == ERR)
 	    goto swe_heliacal_err;
 	  /* determine magnitude of Planet */
 	  if ((retval = Magnitude(JDNarcvisUT, dgeo, ObjectName, helflag, &objectmagn, serr)) == ERR)
 	    goto swe_heliacal_err;
 	} else {
-	  if ((retval = call_swe_fixstar(ObjectName, tjd_tt, iflag, x, serr)) == ERR)
+	  if ((retval = hel_calc(tjd_tt, -1, ObjectName, iflag, x, serr)) == ERR)
 	    goto swe_heliacal_err;
 	}
 	xin[0] = x[0];
@@ -2331,10 +2681,10 @@ static int32 heliacal_ut_arc_vis(double JDNDaysUTStart, double *dgeo, double *da
       JDNarcvisUT = JDNarcvisUT - direct;
       tjd_tt = JDNarcvisUT + swe_deltat_ex(JDNarcvisUT, epheflag, serr);
       if (Planet != -1) {
-	if ((retval = swe_calc(tjd_tt, Planet, iflag, x, serr)) == ERR)
+	if ((retval = hel_calc(tjd_tt, Planet, ObjectName, iflag, x, serr)) == ERR)
 	  goto swe_heliacal_err;
       } else {
-	if ((retval = call_swe_fixstar(ObjectName, tjd_tt, iflag, x, serr)) == ERR)
+	if ((retval = hel_calc(tjd_tt, -1, ObjectName, iflag, x, serr)) == ERR)
 	  goto swe_heliacal_err;
       }
       xin[0] = x[0];
@@ -2364,15 +2714,8 @@ static int32 get_asc_obl(double tjd, int32 ipl, char *star, int32 iflag, double
   int32 epheflag = iflag & (SEFLG_JPLEPH|SEFLG_SWIEPH|SEFLG_MOSEPH);
   double x[6], adp;
   char s[AS_MAXCH];
-  char star2[AS_MAXCH];
-  strcpy(star2, star);
-  if (ipl == -1) {
-    if ((retval = swe_fixstar(star2, tjd, epheflag | SEFLG_EQUATORIAL, x, serr)) == ERR)
-      return ERR;
-  } else {
-    if ((retval = swe_calc(tjd, ipl, epheflag | SEFLG_EQUATORIAL, x, serr)) == ERR)
-      return ERR;
-  }
+  if ((retval = hel_calc(tjd, ipl, star, epheflag | SEFLG_EQUATORIAL, x, serr)) == ERR)
+    return ERR;
   adp = tan(dgeo[1] * DEGTORAD) * tan(x[1] * DEGTORAD);
   if (fabs(adp) > 1) {
     if (star != NULL && *star != '\0')
@@ -2497,9 +2840,9 @@ static int32 find_conjunct_sun(double tjd_start, int32 ipl, int32 helflag, int32
   tjdcon = tjd0 + ((floor) ((tjd_start - tjd0) / dsynperiod) + 1) * dsynperiod;
   ds = 100;
   while (ds > 0.5) {
-    if (swe_calc(tjdcon, ipl, epheflag|SEFLG_SPEED, x, serr) == ERR)
+    if (hel_calc(tjdcon, ipl, "", epheflag|SEFLG_SPEED, x, serr) == ERR)
       return ERR;
-    if (swe_calc(tjdcon, SE_SUN, epheflag|SEFLG_SPEED, xs, serr) == ERR)
+    if (hel_calc(tjdcon, SE_SUN, "", epheflag|SEFLG_SPEED, xs, serr) == ERR)
       return ERR;
     ds = swe_degnorm(x[0] - xs[0] - daspect);
     if (ds > 180) ds -= 360;
@@ -3237,7 +3580,7 @@ static int32 heliacal_ut(double JDNDaysUTStart, double *dgeo, double *datm, doub
 '                   dret[2]: end of visibility (Julian day number; 0 if SE_HELFLAG_AV)
 ' see http://www.iol.ie/~geniet/eng/atmoastroextinction.htm
 */
-int32 swe_heliacal_ut(double JDNDaysUTStart, double *dgeo, double *datm, double *dobs, char *ObjectNameIn, int32 TypeEvent, int32 helflag, double *dret, char *serr_ret)
+static int32 heliacal_event_ut(double JDNDaysUTStart, double *dgeo, double *datm, double *dobs, char *ObjectNameIn, int32 TypeEvent, int32 helflag, double *dret, char *serr_ret)
 {
   int32 retval, Planet, itry;
   char ObjectName[AS_MAXCH], serr[AS_MAXCH], s[AS_MAXCH];
@@ -3367,3 +3710,13 @@ int32 swe_heliacal_ut(double JDNDaysUTStart, double *dgeo, double *datm, double
     strcpy(serr_ret, serr);
   return retval;
 }
+
+int32 swe_heliacal_ut(double JDNDaysUTStart, double *dgeo, double *datm, double *dobs, char *ObjectNameIn, int32 TypeEvent, int32 helflag, double *dret, char *serr_ret)
+{
+  int32 retval;
+  hel_cache_open();
+  SWI_STATS_TIMED(SE_STAT_TIME_HELIACAL, 
+    retval = heliacal_event_ut(JDNDaysUTStart, dgeo, datm, dobs, ObjectNameIn, TypeEvent, helflag, dret, serr_ret));
+  hel_cache_close();
+  return retval;
+}
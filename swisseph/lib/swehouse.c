@@ -175,6 +175,7 @@ int swe_houses_ex(double tjd_ut,
   double tjde = tjd_ut + swe_deltat_ex(tjd_ut, iflag, NULL);
   struct sid_data *sip = &swed.sidd;
   int ito;
+  SWI_STATS_BEGIN(SE_STAT_TIME_HOUSES);
   if (toupper(hsys) == 'G')
     ito = 36;
   else
@@ -221,6 +222,7 @@ int swe_houses_ex(double tjd_ut,
     for (i = 0; i < SE_NASCMC; i++)
       ascmc[i] *= DEGTORAD;
   }
+  SWI_STATS_END(SE_STAT_TIME_HOUSES);
   return retc;
 }
 
@@ -69,6 +69,9 @@
 #include "swephlib.h"
 
 #include "SwissEphGlue.h"
+#ifdef SWE_STATS
+# include <time.h>
+#endif
 
 #define IS_PLANET 		0
 #define IS_MOON			1
@@ -181,15 +184,19 @@ static void nut_matrix(struct nut *nu, struct epsilon *oec);
 static void calc_epsilon(double tjd, int32 iflag, struct epsilon *e);
 static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr);
 static int intp_apsides(double tjd, int ipl, int32 iflag, char *serr); 
+static int plan_for_osc_elem(int32 iflag, double tjd, double *xx, double *nutlo);
 static double meff(double r);
 static void denormalize_positions(double *x0, double *x1, double *x2);
 static void calc_speed(double *x0, double *x1, double *x2, double dt);
 static int32 plaus_iflag(int32 iflag, int32 ipl, double tjd, char *serr);
+static int32 aya_true_star(double tjd_et, int32 iflag, double *daya, char *serr);
 void swe_set_sid_mode(int32 sid_mode, double t0, double ayan_t0);
 static int app_pos_rest(struct plan_data *pdp, int32 iflag, 
     double *xx, double *x2000, struct epsilon *oe, char *serr);
 static int open_jpl_file(double *ss, char *fname, char *fpath, char *serr);
 static void free_planets(void);
+static void read_dpsi_deps(double tjd);
+static void mem_trim(int ifno_keep, int ipl_keep);
 
 #ifdef TRACE
 static void trace_swe_calc(int param, double tjd, int ipl, int32 iflag, double *xx, char *serr);
@@ -226,6 +233,7 @@ int32 swe_calc(double tjd, int ipl, int32 iflag,
   struct save_positions *sd;
   double x[6], *xs, x0[24], x2[24];
   double dt;
+  SWI_STATS_BEGIN(SE_STAT_TIME_CALC);
 #ifdef TRACE
 #ifdef FORCE_IFLAG
   /*
@@ -331,8 +339,10 @@ int32 swe_calc(double tjd, int ipl, int32 iflag,
    */ 
   iflgcoor = SEFLG_EQUATORIAL | SEFLG_XYZ | SEFLG_RADIANS;
   if (sd->tsave == tjd && tjd != 0 && ipl == sd->ipl) {
-    if ((sd->iflgsave & ~iflgcoor) == (iflag & ~iflgcoor)) 
+    if ((sd->iflgsave & ~iflgcoor) == (iflag & ~iflgcoor)) {
+      SWI_STATS_ADD(SE_STAT_SAVED_HITS, 1);
       goto end_swe_calc;
+    }
   }
   /* 
    * otherwise, new position must be computed 
@@ -423,6 +433,7 @@ int32 swe_calc(double tjd, int ipl, int32 iflag,
 #ifdef TRACE
   trace_swe_calc(2, tjd, ipl, iflag, xx, serr);
 #endif
+  SWI_STATS_END(SE_STAT_TIME_CALC);
   return iflag;
 return_error:
   for (i = 0; i <= 5; i++)
@@ -430,6 +441,7 @@ return_error:
 #ifdef TRACE
   trace_swe_calc(2, tjd, ipl, iflag, xx, serr);
 #endif
+  SWI_STATS_END(SE_STAT_TIME_CALC);
   return ERR; 
 }
 
@@ -455,6 +467,60 @@ int32 swe_calc_ut(double tjd_ut, int32 ipl, int32 iflag,
   return retval;
 }
 
+/* osculating lunar node, apogee and perigee from one set of lunar 
+ * positions. xnode and xapog are what swe_calc() returns for SE_TRUE_NODE 
+ * and SE_OSCU_APOG; xperg is the perigee, which has no body number. 
+ * returns the iflag of xnode, or ERR. */
+int32 swe_lunar_osc_elem(double tjd_et, int32 iflag, double *xnode, 
+	double *xapog, double *xperg, char *serr)
+{
+  int i;
+  int32 retflag;
+  double *xs;
+  struct plan_data *ndp = &swed.nddat[SEI_OSCU_PERG];
+  if ((retflag = swe_calc(tjd_et, SE_TRUE_NODE, iflag, xnode, serr)) == ERR)
+    goto return_error;
+  if (swe_calc(tjd_et, SE_OSCU_APOG, iflag, xapog, serr) == ERR)
+    goto return_error;
+  /* the perigee has been computed with node and apogee, unless both
+   * came from the save area of swe_calc() */
+  iflag = plaus_iflag(iflag, SE_OSCU_APOG, tjd_et, serr);
+  swi_check_ecliptic(tjd_et, iflag);
+  swi_check_nutation(tjd_et, iflag);
+  if (lunar_osc_elem(tjd_et, SEI_OSCU_PERG, iflag, serr) == ERR)
+    goto return_error;
+  /* output as in swe_calc() */
+  if (iflag & SEFLG_EQUATORIAL)
+    xs = ndp->xreturn+12;
+  else
+    xs = ndp->xreturn;
+  if (iflag & SEFLG_XYZ)
+    xs = xs+6;
+  for (i = 0; i <= 5; i++)
+    xperg[i] = xs[i];
+  if (!(iflag & (SEFLG_SPEED3 | SEFLG_SPEED))) {
+    for (i = 3; i <= 5; i++)
+      xperg[i] = 0;
+  }
+  if ((iflag & SEFLG_RADIANS) && !(iflag & SEFLG_XYZ)) {
+    for (i = 0; i <= 4; i++)
+      if (i != 2)
+        xperg[i] *= DEGTORAD;
+  }
+  return retflag;
+return_error:
+  for (i = 0; i <= 5; i++)
+    xnode[i] = xapog[i] = xperg[i] = 0;
+  return ERR;
+}
+
+int32 swe_lunar_osc_elem_ut(double tjd_ut, int32 iflag, double *xnode, 
+	double *xapog, double *xperg, char *serr)
+{
+  return swe_lunar_osc_elem(tjd_ut + swe_deltat_ex(tjd_ut, iflag, serr), 
+	iflag, xnode, xapog, xperg, serr);
+}
+
 static int32 swecalc(double tjd, int ipl, int32 iflag, double *x, char *serr) 
 {
   int i;
@@ -1089,7 +1155,9 @@ int32 swi_init_swed_if_start(void)
 {
   /* initialisation of swed, when called first time from */
   if (!swed.ephe_path_is_set) {
+    struct stats_data stats = swed.stats;
     memset((void *) &swed, 0, sizeof(struct swe_data));
+    swed.stats = stats;
     strcpy(swed.ephepath, SE_EPHE_PATH);
     strcpy(swed.jplfnam, SE_FNAME_DFT);
     swe_set_tid_acc(SE_TIDAL_AUTOMATIC);
@@ -1116,6 +1184,12 @@ static void swi_close_keep_topo_etc(void)
   memset((void *) &swed.nut, 0, sizeof(struct nut));
   memset((void *) &swed.nut2000, 0, sizeof(struct nut));
   memset((void *) &swed.nutv, 0, sizeof(struct nut));
+  memset((void *) &swed.nutprev, 0, sizeof(struct nut));
+  memset((void *) &swed.nutvprev, 0, sizeof(struct nut));
+  swed.nutprevflag = 0;
+  memset((void *) &swed.ayac, 0, sizeof(struct aya_cache));
+  memset((void *) swed.intpc, 0, sizeof(swed.intpc));
+  memset((void *) &swed.oscm, 0, sizeof(struct osc_moon));
   memset((void *) &swed.astro_models, SEI_NMODELS, sizeof(int32));
   /* close JPL file */
   swi_close_jpl_file();
@@ -1151,6 +1225,12 @@ void swe_close(void)
   memset((void *) &swed.nut, 0, sizeof(struct nut));
   memset((void *) &swed.nut2000, 0, sizeof(struct nut));
   memset((void *) &swed.nutv, 0, sizeof(struct nut));
+  memset((void *) &swed.nutprev, 0, sizeof(struct nut));
+  memset((void *) &swed.nutvprev, 0, sizeof(struct nut));
+  swed.nutprevflag = 0;
+  memset((void *) &swed.ayac, 0, sizeof(struct aya_cache));
+  memset((void *) swed.intpc, 0, sizeof(swed.intpc));
+  memset((void *) &swed.oscm, 0, sizeof(struct osc_moon));
   memset((void *) &swed.astro_models, SEI_NMODELS, sizeof(int32));
   /* close JPL file */
   swi_close_jpl_file();
@@ -1179,6 +1259,8 @@ void swe_close(void)
     free(swed.deps);
     swed.deps = NULL;
   }
+  swed.eop_windowed = FALSE;
+  swed.eop_nwin = 0;
 /*  swed.ephe_path_is_set = FALSE;
   *swed.ephepath = '\0'; */
 #ifdef TRACE
@@ -1206,6 +1288,252 @@ void swe_close(void)
 #endif  /* TRACE */
 }
 
+/**********************************************************
+ * bounded memory mode
+ * With a limit set by swe_set_memory_limit(), the memory that a thread
+ * allocates for its ephemeris data is trimmed whenever it grows beyond the
+ * limit. In this order, and each time least recently used first:
+ * - the daily table of dpsi and deps (SEFLG_JPLHOR) is replaced by a
+ *   window of SWE_DATA_DPSI_DEPS_WIN days,
+ * - chebyshew coefficients of ephemeris segments are freed; they are
+ *   read again from the file when they are needed,
+ * - the fixed stars file is closed,
+ * - ephemeris files are closed, together with the coefficients of the
+ *   bodies in them. The Moon file stays open: swi_get_tid_acc() takes its
+ *   DE number, and an open file, as the ephemeris in use.
+ * The file and segment of the computation in progress are always kept, so
+ * the limit is not a hard one. Fixed size data (struct swe_data and the
+ * static tables of the library) are not counted.
+ **********************************************************/
+static TLS int32 mem_limit = 0;
+/* last use of files and segments, counted only while there is a limit.
+ * The counter wraps around; ages are taken as differences to it. */
+static TLS uint32 mem_tick = 0;
+static TLS uint32 mem_file_tick[SEI_NEPHFILES];
+static TLS uint32 mem_seg_tick[SEI_NPLANETS];
+
+static int32 mem_segments(void)
+{
+  int i;
+  int32 nbytes = 0;
+  for (i = 0; i < SEI_NPLANETS; i++) {
+    if (swed.pldat[i].segp != NULL)
+      nbytes += swed.pldat[i].ncoe * 3 * 8;
+    if (swed.pldat[i].refep != NULL)
+      nbytes += swed.pldat[i].ncoe * 2 * 8;
+  }
+  return nbytes;
+}
+
+static int32 mem_dpsi_deps(void)
+{
+  if (swed.dpsi == NULL)
+    return 0;
+  if (swed.eop_windowed)
+    return 2 * SWE_DATA_DPSI_DEPS_WIN * (int32) sizeof(double);
+  return 2 * SWE_DATA_DPSI_DEPS * (int32) sizeof(double);
+}
+
+/* open files, each of them with a stdio buffer of about BUFSIZ bytes */
+static int32 mem_files(void)
+{
+  int i;
+  int32 nfiles = 0;
+  for (i = 0; i < SEI_NEPHFILES; i++) {
+    if (swed.fidat[i].fptr != NULL)
+      nfiles++;
+  }
+  if (swed.fixfp != NULL)
+    nfiles++;
+  if (swed.jpl_file_is_open)
+    nfiles++;
+  return nfiles;
+}
+
+static int32 mem_usage(void)
+{
+  return mem_segments() + mem_dpsi_deps() + mem_files() * BUFSIZ;
+}
+
+/* whether the whole table of dpsi and deps would exceed the limit */
+static AS_BOOL dpsi_deps_need_window(void)
+{
+  int32 nbytes = mem_usage() - mem_dpsi_deps();
+  if (mem_limit <= 0)
+    return FALSE;
+  return nbytes + 2 * SWE_DATA_DPSI_DEPS * (int32) sizeof(double) > mem_limit;
+}
+
+/* closes ephemeris file ifno and frees the coefficients read from it */
+static void close_ephe_file(int ifno)
+{
+  int i, ipli;
+  struct file_data *fdp = &swed.fidat[ifno];
+  struct plan_data *pdp;
+  fclose(fdp->fptr);
+  fdp->fptr = NULL;
+  for (i = 0; i < fdp->npl; i++) {
+    ipli = fdp->ipl[i];
+    if (ipli >= SE_AST_OFFSET)
+      pdp = &swed.pldat[SEI_ANYBODY];
+    else if (ipli >= 0 && ipli < SEI_NPLANETS)
+      pdp = &swed.pldat[ipli];
+    else
+      continue;
+    if (pdp->refep != NULL) 
+      free((void *) pdp->refep);
+    pdp->refep = NULL;
+    if (pdp->segp != NULL)
+      free((void *) pdp->segp);
+    pdp->segp = NULL;
+  }
+}
+
+/* frees memory until the limit is kept; file ifno_keep and the segment
+ * of planet ipl_keep are in use (-1 for none) */
+static void mem_trim(int ifno_keep, int ipl_keep)
+{
+  int i, ilru;
+  if (mem_limit <= 0 || mem_usage() <= mem_limit)
+    return;
+  if (swed.dpsi != NULL && !swed.eop_windowed && swed.eop_dpsi_loaded > 0) {
+    free(swed.dpsi);
+    free(swed.deps);
+    swed.dpsi = swed.deps = NULL;
+    read_dpsi_deps(0);
+  }
+  while (mem_usage() > mem_limit) {
+    for (i = 0, ilru = -1; i < SEI_NPLANETS; i++) {
+      if (i == ipl_keep || swed.pldat[i].segp == NULL)
+	continue;
+      if (ilru < 0 || mem_tick - mem_seg_tick[i] > mem_tick - mem_seg_tick[ilru])
+	ilru = i;
+    }
+    if (ilru < 0)
+      break;
+    free((void *) swed.pldat[ilru].segp);
+    swed.pldat[ilru].segp = NULL;
+  }
+  if (mem_usage() > mem_limit && swed.fixfp != NULL) {
+    fclose(swed.fixfp);
+    swed.fixfp = NULL;
+  }
+  while (mem_usage() > mem_limit) {
+    for (i = 0, ilru = -1; i < SEI_NEPHFILES; i++) {
+      if (i == ifno_keep || i == SEI_FILE_MOON || swed.fidat[i].fptr == NULL)
+	continue;
+      if (ilru < 0 || mem_tick - mem_file_tick[i] > mem_tick - mem_file_tick[ilru])
+	ilru = i;
+    }
+    if (ilru < 0)
+      break;
+    close_ephe_file(ilru);
+  }
+}
+
+/* sets the limit in bytes of the memory that the calling thread may
+ * allocate for ephemeris data; 0 for no limit (default). */
+void swe_set_memory_limit(int32 nbytes)
+{
+  swi_init_swed_if_start();
+  mem_limit = nbytes > 0 ? nbytes : 0;
+  /* with a new limit, the whole table of dpsi and deps may fit again */
+  if (swed.dpsi != NULL && swed.eop_dpsi_loaded > 0 
+    && swed.eop_windowed != dpsi_deps_need_window())
+    read_dpsi_deps(swed.eop_tjd_win + SWE_DATA_DPSI_DEPS_WIN / 2);
+  mem_trim(-1, -1);
+}
+
+/* memory used by the calling thread for ephemeris data:
+ * stats[0] = bytes in use, the sum of the following ones,
+ *            which swe_set_memory_limit() applies to
+ * stats[1] = chebyshew coefficients of ephemeris segments
+ * stats[2] = daily nutation corrections dpsi and deps (SEFLG_JPLHOR)
+ * stats[3] = buffers of open files, estimated
+ * stats[4] = number of open files
+ * stats[5] = fixed size data of the thread, not included in stats[0]
+ * returns the current limit, 0 if there is none.
+ */
+int32 swe_get_memory_stats(int32 *stats)
+{
+  stats[1] = mem_segments();
+  stats[2] = mem_dpsi_deps();
+  stats[4] = mem_files();
+  stats[3] = stats[4] * BUFSIZ;
+  stats[0] = stats[1] + stats[2] + stats[3];
+  stats[5] = (int32) sizeof(struct swe_data);
+  return mem_limit;
+}
+
+#ifdef SWE_STATS
+static double stats_clock(void)
+{
+  struct timespec ts;
+#if MSDOS
+  timespec_get(&ts, TIME_UTC);
+#else
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+/* timer i of swe_get_stats(); only the outermost of nested calls
+ * of the same timer is measured, e.g. swe_calc() called by swe_fixstar() 
+ * for the Earth counts to both SE_STAT_TIME_CALC and SE_STAT_TIME_FIXSTAR, 
+ * but recursive calls of swe_calc() are measured once. */
+double swi_stats_begin(int i)
+{
+#ifdef SWE_STATS
+  if (swed.stats.depth[i]++ == 0)
+    return stats_clock();
+#endif
+  return 0;
+}
+
+void swi_stats_end(int i, double t0)
+{
+#ifdef SWE_STATS
+  if (swed.stats.depth[i] <= 0)
+    return;
+  if (--swed.stats.depth[i] == 0) {
+    swed.stats.seconds[i] += stats_clock() - t0;
+    swed.stats.calls[i]++;
+  }
+#endif
+}
+
+/* counters and timers of the calling thread, see SE_STAT_... in swephexp.h:
+ * counters[SE_NSTAT_COUNTERS]
+ * timers[2 * SE_NSTAT_TIMERS], number of calls and seconds of each timer
+ * returns OK, or ERR with all zeros if the library was compiled
+ * without SWE_STATS.
+ */
+int32 swe_get_stats(double *counters, double *timers)
+{
+  int i;
+  for (i = 0; i < SE_NSTAT_COUNTERS; i++)
+    counters[i] = swed.stats.count[i];
+  for (i = 0; i < SE_NSTAT_TIMERS; i++) {
+    timers[2 * i] = swed.stats.calls[i];
+    timers[2 * i + 1] = swed.stats.seconds[i];
+  }
+#ifdef SWE_STATS
+  return OK;
+#else
+  return ERR;
+#endif
+}
+
+/* resets the counters and timers of the calling thread; 
+ * swe_close() does not reset them. */
+void swe_reset_stats(void)
+{
+  memset((void *) swed.stats.count, 0, sizeof(swed.stats.count));
+  memset((void *) swed.stats.calls, 0, sizeof(swed.stats.calls));
+  memset((void *) swed.stats.seconds, 0, sizeof(swed.stats.seconds));
+}
+
 /* sets ephemeris file path. 
  * also calls swe_close(). this makes sure that swe_calc()
  * won't return planet positions previously computed from other
@@ -1272,28 +1600,57 @@ void swe_set_ephe_path(char *path)
 #endif
 }
 
-void load_dpsi_deps(void)
+/* stores the corrections of day n of the files if it is within the
+ * window that starts on day n0 */
+static void store_dpsi_deps(int n, int n0, double dpsi, double deps)
+{
+  int nmax = swed.eop_windowed ? SWE_DATA_DPSI_DEPS_WIN : SWE_DATA_DPSI_DEPS;
+  if (n < n0 || n - n0 >= nmax)
+    return;
+  swed.dpsi[n - n0] = dpsi;
+  swed.deps[n - n0] = deps;
+  if (n - n0 >= swed.eop_nwin)
+    swed.eop_nwin = n - n0 + 1;
+}
+
+/* reads dpsi and deps from the EOP files. In bounded memory mode, if the
+ * whole table does not fit into the limit, only SWE_DATA_DPSI_DEPS_WIN days
+ * around tjd are kept; swi_move_dpsi_deps_window() rereads the files when
+ * a date outside the window is needed. */
+static void read_dpsi_deps(double tjd)
 {
   FILE *fp;
   char s[AS_MAXCH];
   char *cpos[20];
-  int n = 0, np, iyear, mjd = 0, mjdsv = 0;
+  int n = 0, n0 = 0, np, iyear, mjd = 0, mjdsv = 0;
   double dpsi, deps, TJDOFS = 2400000.5;
-  if (swed.eop_dpsi_loaded > 0) 
-    return;
+  AS_BOOL windowed;
   fp = swi_fopen(-1, DPSI_DEPS_IAU1980_FILE_EOPC04, swed.ephepath, NULL);
   if (fp == NULL) {
     swed.eop_dpsi_loaded = ERR;
     return;
   }
-  if ((swed.dpsi = (double *) calloc((size_t) SWE_DATA_DPSI_DEPS, sizeof(double))) == NULL) {
+  windowed = dpsi_deps_need_window();
+  if (swed.dpsi != NULL && windowed != swed.eop_windowed) {
+    free(swed.dpsi);
+    free(swed.deps);
+    swed.dpsi = swed.deps = NULL;
+  }
+  swed.eop_windowed = windowed;
+  np = windowed ? SWE_DATA_DPSI_DEPS_WIN : SWE_DATA_DPSI_DEPS;
+  if (swed.dpsi == NULL
+    && (swed.dpsi = (double *) calloc((size_t) np, sizeof(double))) == NULL) {
     swed.eop_dpsi_loaded = ERR;
+    fclose(fp);
     return;
   }
-  if ((swed.deps = (double *) calloc((size_t) SWE_DATA_DPSI_DEPS, sizeof(double))) == NULL) {
+  if (swed.deps == NULL
+    && (swed.deps = (double *) calloc((size_t) np, sizeof(double))) == NULL) {
     swed.eop_dpsi_loaded = ERR;
+    fclose(fp);
     return;
   }
+  swed.eop_nwin = 0;
   swed.eop_tjd_beg_horizons = DPSI_DEPS_IAU1980_TJD0_HORIZONS;
   while (fgets(s, AS_MAXCH, fp) != NULL) {
     np = swi_cutstr(s, " ", cpos, 16);
@@ -1307,11 +1664,17 @@ void load_dpsi_deps(void)
       fclose(fp);
       return;
     }
-    if (n == 0)
+    if (n == 0) {
       swed.eop_tjd_beg = mjd + TJDOFS;
-    swed.dpsi[n] = atof(cpos[8]);
-    swed.deps[n] = atof(cpos[9]);
-/*    fprintf(stderr, "tjd=%f, dpsi=%f, deps=%f\n", mjd + 2400000.5, swed.dpsi[n] * 1000, swed.deps[n] * 1000);exit(0);*/
+      if (windowed) {
+	n0 = (int) (tjd - swed.eop_tjd_beg) - SWE_DATA_DPSI_DEPS_WIN / 2;
+	if (n0 < 0)
+	  n0 = 0;
+	swed.eop_tjd_win = swed.eop_tjd_beg + n0;
+      }
+    }
+    store_dpsi_deps(n, n0, atof(cpos[8]), atof(cpos[9]));
+/*    fprintf(stderr, "tjd=%f, dpsi=%f, deps=%f\n", mjd + 2400000.5, atof(cpos[8]) * 1000, atof(cpos[9]) * 1000);exit(0);*/
     n++;
     mjdsv = mjd;
   }
@@ -1352,9 +1715,8 @@ void load_dpsi_deps(void)
       return;
     }
     swed.eop_tjd_end = mjd + TJDOFS;
-    swed.dpsi[n] = dpsi / 1000.0;
-    swed.deps[n] = deps / 1000.0;
-    /*fprintf(stderr, "tjd=%f, dpsi=%f, deps=%f\n", mjd + 2400000.5, swed.dpsi[n] * 1000, swed.deps[n] * 1000);*/
+    store_dpsi_deps(n, n0, dpsi / 1000.0, deps / 1000.0);
+    /*fprintf(stderr, "tjd=%f, dpsi=%f, deps=%f\n", mjd + 2400000.5, dpsi, deps);*/
     n++;
     mjdsv = mjd;
   }
@@ -1362,6 +1724,29 @@ void load_dpsi_deps(void)
   fclose(fp);
 }
 
+void load_dpsi_deps(void)
+{
+  if (swed.eop_dpsi_loaded > 0) 
+    return;
+  read_dpsi_deps(0);
+}
+
+/* makes sure the window of dpsi and deps covers tjd, with the three days
+ * on either side that bessel() interpolates from */
+void swi_move_dpsi_deps_window(double tjd)
+{
+  double t = tjd - swed.eop_tjd_win;
+  if (!swed.eop_windowed || swed.eop_dpsi_loaded <= 0)
+    return;
+  if ((t >= 3 || swed.eop_tjd_win <= swed.eop_tjd_beg)
+    && (t <= swed.eop_nwin - 5 
+    || swed.eop_tjd_win + swed.eop_nwin - 1 >= swed.eop_tjd_end))
+    return;
+  if (tjd > swed.eop_tjd_end)
+    tjd = swed.eop_tjd_end;
+  read_dpsi_deps(tjd);
+}
+
 /* sets jpl file name.
  * also calls swe_close(). this makes sure that swe_calc()
  * won't return planet positions previously computed from other
@@ -2128,7 +2513,9 @@ again:
    ******************************/
   /* get new segment, if necessary */
   if (pdp->segp == NULL || tjd < pdp->tseg0 || tjd > pdp->tseg1) {
-    retc = get_new_segment(tjd, ipl, ifno, serr);
+    SWI_STATS_ADD(SE_STAT_SEGMENTS, 1);
+    SWI_STATS_TIMED(SE_STAT_TIME_SEGMENTS, 
+      retc = get_new_segment(tjd, ipl, ifno, serr));
     if (retc != OK)
       return(retc);
     /* rotate cheby coeffs back to equatorial system.
@@ -2137,7 +2524,11 @@ again:
       rot_back(ipl); /**/
     else
       pdp->neval = pdp->ncoe;
+    /* in bounded memory mode, make room for it */
+    mem_trim(ifno, ipl);
   }
+  if (mem_limit > 0)
+    mem_file_tick[ifno] = mem_seg_tick[ipl] = ++mem_tick;
   /* evaluate chebyshew polynomial for tjd */
   t = (tjd - pdp->tseg0) / pdp->dseg;
   t = t * 2 - 1;
@@ -2244,6 +2635,7 @@ FILE *swi_fopen(int ifno, char *fname, char *ephepath, char *serr)
       return NULL;
     }
     strcpy(fnamp, s);
+    SWI_STATS_ADD(SE_STAT_FILE_OPENS, 1);
     fp = fopen(fnamp, BFILE_R_ACCESS);
     if (fp != NULL) 
       return fp;
@@ -2726,25 +3118,14 @@ void swe_set_sid_mode(int32 sid_mode, double t0, double ayan_t0)
   swi_force_app_pos_etc();
 }
 
-int32 swe_get_ayanamsa_ex(double tjd_et, int32 iflag, double *daya, char *serr)
+/* ayanamsa of the true star modes, from the longitude of the star 
+ * at tjd_et */
+static int32 aya_true_star_exact(double tjd_et, int32 iflag, double *daya, char *serr)
 {
-  double x[6], eps;
+  double x[6];
   struct sid_data *sip = &swed.sidd;
   char star[AS_MAXCH];
-  int32 epheflag, otherflag, retflag;
-  iflag = plaus_iflag(iflag, -1, tjd_et, serr);
-  epheflag = iflag & SEFLG_EPHMASK;
-  otherflag = iflag & ~SEFLG_EPHMASK;
-  *daya = 0.0;
-  iflag &= SEFLG_EPHMASK;
-  iflag |= SEFLG_NONUT;
-  /* warning, if swe_set_ephe_path() or swe_set_jplfile() was not called yet,
-   * although ephemeris files are required */
-  if (swi_init_swed_if_start() == 1 && !(epheflag & SEFLG_MOSEPH) && (sip->sid_mode ==  SE_SIDM_TRUE_CITRA || sip->sid_mode == SE_SIDM_TRUE_REVATI || sip->sid_mode == SE_SIDM_TRUE_PUSHYA) && serr != NULL) {
-    strcpy(serr, "Please call swe_set_ephe_path() or swe_set_jplfile() before calling swe_get_ayanamsa_ex()");
-  }
-  if (!swed.ayana_is_set)
-    swe_set_sid_mode(SE_SIDM_FAGAN_BRADLEY, 0, 0);
+  int32 retflag;
   if (sip->sid_mode == SE_SIDM_TRUE_CITRA) {
     strcpy(star, "Spica"); /* Citra */
     if ((retflag = swe_fixstar(star, tjd_et, iflag, x, serr)) == ERR) {
@@ -2762,13 +3143,132 @@ int32 swe_get_ayanamsa_ex(double tjd_et, int32 iflag, double *daya, char *serr)
     return (retflag & SEFLG_EPHMASK);
     /*return swe_degnorm(x[0] - 359.83333333334);*/
   }
-  if (sip->sid_mode == SE_SIDM_TRUE_PUSHYA) {
-    strcpy(star, ",deCnc"); /* Pushya = Asellus Australis */
-    if ((retflag = swe_fixstar(star, tjd_et, iflag, x, serr)) == ERR)
+  /* SE_SIDM_TRUE_PUSHYA */
+  strcpy(star, ",deCnc"); /* Pushya = Asellus Australis */
+  if ((retflag = swe_fixstar(star, tjd_et, iflag, x, serr)) == ERR)
+    return ERR;
+  *daya = swe_degnorm(x[0] - 106);
+  return (retflag & SEFLG_EPHMASK);
+}
+
+/* Chebyshew interpolation of the ayanamsa over the window of f, at 
+ * AYA_FIT_NCOEF nodes. The fit is checked against the star halfway 
+ * between each two nodes and at both ends of the window, where the error 
+ * of the interpolation is largest; if it is off by more than AYA_FIT_MAXERR, 
+ * f->retflag is set to -1. This happens in windows near the conjunction 
+ * of the star with the sun, where light deflection changes too fast. */
+static int32 aya_make_fit(struct aya_fit *f, int32 iflag, char *serr)
+{
+  double y[AYA_FIT_NCOEF], daya, dt = AYA_FIT_DAYS / 2.0, tmid = f->tbeg + dt;
+  double xk, sum;
+  int32 retflag = 0, ret;
+  int j, k;
+  for (k = 0; k < AYA_FIT_NCOEF; k++) {
+    xk = cos(PI * (k + 0.5) / AYA_FIT_NCOEF);
+    if ((ret = aya_true_star_exact(tmid + dt * xk, iflag, &y[k], serr)) == ERR)
       return ERR;
-    *daya = swe_degnorm(x[0] - 106);
-    return (retflag & SEFLG_EPHMASK);
+    if (k > 0 && ret != retflag)
+      retflag = -1;	/* ephemeris changes within the window */
+    else if (retflag >= 0)
+      retflag = ret;
+    /* continuous where the ayanamsa passes 0 */
+    if (k > 0)
+      y[k] = y[0] + swe_difdeg2n(y[k], y[0]);
+  }
+  for (j = 0; j < AYA_FIT_NCOEF; j++) {
+    sum = 0;
+    for (k = 0; k < AYA_FIT_NCOEF; k++)
+      sum += y[k] * cos(PI * j * (k + 0.5) / AYA_FIT_NCOEF);
+    f->coef[j] = sum * 2 / AYA_FIT_NCOEF;
+  }
+  for (k = 0; k <= AYA_FIT_NCOEF && retflag >= 0; k++) {
+    xk = cos(PI * k / AYA_FIT_NCOEF);
+    if ((ret = aya_true_star_exact(tmid + dt * xk, iflag, &daya, serr)) == ERR)
+      return ERR;
+    if (ret != retflag || fabs(swe_difdeg2n(swi_echeb(xk, f->coef, AYA_FIT_NCOEF), daya)) * 3600 > AYA_FIT_MAXERR)
+      retflag = -1;
+  }
+  f->retflag = retflag;
+  return OK;
+}
+
+/* swe_get_ayanamsa_ex() for the true star modes, whose ayanamsa needs 
+ * the apparent position of a star. Charts ask for the ayanamsa of the 
+ * same date many times: the last value is kept. Series of charts ask 
+ * for nearby dates: the second date in a window of AYA_FIT_DAYS days 
+ * gets a chebyshew fit over the window (see aya_make_fit()), which serves 
+ * all further dates in it. The error of the fits is below AYA_FIT_MAXERR. */
+static int32 aya_true_star(double tjd_et, int32 iflag, double *daya, char *serr)
+{
+  struct aya_cache *ac = &swed.ayac;
+  struct aya_fit *f;
+  int32 sid_mode = swed.sidd.sid_mode, retflag;
+  double tbeg = floor(tjd_et / AYA_FIT_DAYS) * AYA_FIT_DAYS;
+  double x;
+  int i;
+  AS_BOOL same_mode = (ac->sid_mode == sid_mode && ac->iflag == iflag);
+  if (same_mode && ac->tjd == tjd_et) {
+    *daya = ac->daya;
+    return ac->retflag;
+  }
+  for (i = 0; i < ac->nfit; i++) {
+    f = &ac->fit[i];
+    if (f->tbeg == tbeg && f->sid_mode == sid_mode && f->iflag == iflag)
+      break;
   }
+  /* second date in the window of the last one */
+  if (i == ac->nfit && same_mode && floor(ac->tjd / AYA_FIT_DAYS) * AYA_FIT_DAYS == tbeg) {
+    f = &ac->fit[ac->ifit];
+    f->tbeg = tbeg;
+    f->sid_mode = sid_mode;
+    f->iflag = iflag;
+    if (aya_make_fit(f, iflag, serr) == ERR) {
+      f->sid_mode = -1;
+      return ERR;
+    }
+    i = ac->ifit;
+    ac->ifit = (ac->ifit + 1) % AYA_NFIT;
+    if (ac->nfit < AYA_NFIT)
+      ac->nfit++;
+  }
+  if (i < ac->nfit && ac->fit[i].retflag >= 0) {
+    f = &ac->fit[i];
+    x = (tjd_et - tbeg) / AYA_FIT_DAYS * 2 - 1;
+    *daya = swe_degnorm(swi_echeb(x, f->coef, AYA_FIT_NCOEF));
+    return f->retflag;
+  }
+  if ((retflag = aya_true_star_exact(tjd_et, iflag, daya, serr)) == ERR)
+    return ERR;
+  ac->tjd = tjd_et;
+  ac->sid_mode = sid_mode;
+  ac->iflag = iflag;
+  ac->retflag = retflag;
+  ac->daya = *daya;
+  return retflag;
+}
+
+int32 swe_get_ayanamsa_ex(double tjd_et, int32 iflag, double *daya, char *serr)
+{
+  double x[6], eps;
+  struct sid_data *sip = &swed.sidd;
+  int32 epheflag, otherflag, retflag;
+  iflag = plaus_iflag(iflag, -1, tjd_et, serr);
+  epheflag = iflag & SEFLG_EPHMASK;
+  otherflag = iflag & ~SEFLG_EPHMASK;
+  *daya = 0.0;
+  iflag &= SEFLG_EPHMASK;
+  iflag |= SEFLG_NONUT;
+  /* warning, if swe_set_ephe_path() or swe_set_jplfile() was not called yet,
+   * although ephemeris files are required */
+  if (swi_init_swed_if_start() == 1 && !(epheflag & SEFLG_MOSEPH) && (sip->sid_mode ==  SE_SIDM_TRUE_CITRA || sip->sid_mode == SE_SIDM_TRUE_REVATI || sip->sid_mode == SE_SIDM_TRUE_PUSHYA) && serr != NULL) {
+    strcpy(serr, "Please call swe_set_ephe_path() or swe_set_jplfile() before calling swe_get_ayanamsa_ex()");
+  }
+  if (!swed.ayana_is_set)
+    swe_set_sid_mode(SE_SIDM_FAGAN_BRADLEY, 0, 0);
+  if (sip->sid_mode == SE_SIDM_TRUE_CITRA 
+    || sip->sid_mode == SE_SIDM_TRUE_REVATI 
+    || sip->sid_mode == SE_SIDM_TRUE_PUSHYA)
+    return aya_true_star(tjd_et, iflag, daya, serr);
   /* vernal point (tjd), cartesian */
   x[0] = 1; 
   x[1] = x[2] = 0;
@@ -4400,6 +4900,7 @@ static int do_fread(void *trg, int size, int count, int corrsize, FILE *fp, int3
   unsigned char space[1000];
   unsigned char *targ = (unsigned char *) trg;
   totsize = size * count;
+  SWI_STATS_ADD(SE_STAT_READ_BYTES, totsize);
   if (fpos >= 0) 
     fseek(fp, fpos, SEEK_SET);
   /* if no byte reorder has to be done, and read size == return size */
@@ -4585,7 +5086,8 @@ static void nut_matrix(struct nut *nu, struct epsilon *oe)
  * osculating node ('true' node) and
  * osculating apogee ('black moon', 'lilith').
  * tjd		julian day
- * ipl		body number, i.e. SEI_TRUE_NODE or SEI_OSCU_APOG
+ * ipl		body number, i.e. SEI_TRUE_NODE, SEI_OSCU_APOG or
+ *		SEI_OSCU_PERG; all three are computed
  * iflag	flags (which ephemeris, nutation, etc.)
  * serr		error string
  *
@@ -4664,12 +5166,15 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
 #if 0
   struct node_data *ndp, *ndnp, *ndap;
 #else
-  struct plan_data *ndp, *ndnp, *ndap;
+  struct plan_data *ndp, *ndnp, *ndap, *ndpp;
 #endif
+  struct osc_moon *om = &swed.oscm;
+  int32 mflags;
+  double nutx[2], *pnutx = NULL;
   struct epsilon *oe;
   double speed_intv = NODE_CALC_INTV;	/* to silence gcc warning */
   double a, b;
-  double xpos[3][6], xx[3][6], xxa[3][6], xnorm[6], r[6];
+  double xpos[3][6], xx[3][6], xxa[3][6], xxp[3][6], xnorm[6], r[6];
   double *xp;
   double rxy, rxyz, t, dt, fac, sgn;
   double sinnode, cosnode, sinincl, cosincl, sinu, cosu, sinE, cosE;
@@ -4736,6 +5241,29 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
     istart = 2;
   if (serr != NULL)
     *serr = '\0';
+  /* the lunar positions of the last date serve all output flags,
+   * e.g. tropical and sidereal, node and apogee with and without speed */
+  mflags = iflag & (SEFLG_EPHMASK | SEFLG_TRUEPOS | SEFLG_NONUT | SEFLG_ICRS 
+                    | SEFLG_JPLHOR | SEFLG_JPLHOR_APPROX);
+  if (tjd == om->tjd && tjd != 0 && mflags == om->iflag && om->istart <= istart) {
+    epheflag = om->epheflag;
+    iflag = (iflag & ~SEFLG_EPHMASK) | epheflag;
+    speed_intv = om->speed_intv;
+    for (i = istart; i <= 2; i++)
+      for (j = 0; j <= 5; j++)
+        xpos[i][j] = om->xpos[i][j];
+    goto osc_elements;
+  }
+  /* swe_calc() has computed the nutation of tjd and, for the speed, of 
+   * tjd - NUT_SPEED_INTV, which is the first position with jpl and 
+   * swisseph. the nutation of the last position, tjd + NODE_CALC_INTV, 
+   * is extrapolated from them; the error is below 1e-9". */
+  if (!(iflag & SEFLG_NONUT) && swed.nut.tnut == tjd 
+	&& swed.nutv.tnut == tjd - NODE_CALC_INTV) {
+    for (i = 0; i <= 1; i++)
+      nutx[i] = 2 * swed.nut.nutlo[i] - swed.nutv.nutlo[i];
+    pnutx = nutx;
+  }
   three_positions:
   switch(epheflag) {
     case SEFLG_JPLEPH:
@@ -4783,7 +5311,7 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
 	    return ERR;
 	}
 	/* precession and nutation etc. */
-	retc = swi_plan_for_osc_elem(iflag|SEFLG_SPEED, t, xpos[i]); /* retc is always ok */
+	retc = plan_for_osc_elem(iflag|SEFLG_SPEED, t, xpos[i], i == 1 ? pnutx : NULL); /* retc is always ok */
       }
       break;
     case SEFLG_SWIEPH:
@@ -4819,7 +5347,7 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
 	    return ERR;
 	}
 	/* precession and nutation etc. */
-	retc = swi_plan_for_osc_elem(iflag|SEFLG_SPEED, t, xpos[i]); /* retc is always ok */
+	retc = plan_for_osc_elem(iflag|SEFLG_SPEED, t, xpos[i], i == 1 ? pnutx : NULL); /* retc is always ok */
       }
       break;
     case SEFLG_MOSEPH:
@@ -4856,6 +5384,15 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
   } 
   if (retc == NOT_AVAILABLE || retc == BEYOND_EPH_LIMITS)
     goto three_positions;
+  om->tjd = tjd;
+  om->iflag = mflags;
+  om->epheflag = epheflag;
+  om->istart = istart;
+  om->speed_intv = speed_intv;
+  for (i = istart; i <= 2; i++)
+    for (j = 0; j <= 5; j++)
+      om->xpos[i][j] = xpos[i][j];
+  osc_elements:
   /*********************************************
    * node with speed                           * 
    *********************************************/
@@ -4895,6 +5432,7 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
    * must be computed anyway to get the node's distance       *
    ************************************************************/
   ndap = &swed.nddat[SEI_OSCU_APOG];
+  ndpp = &swed.nddat[SEI_OSCU_PERG];
   Gmsm = GEOGCONST * (1 + 1 / EARTH_MOON_MRAT) /AUNIT/AUNIT/AUNIT*86400.0*86400.0;
   /* three apogees */
   for (i = istart; i <= 2; i++) {
@@ -4937,6 +5475,15 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
     /* adding node, we get apogee in ecl. coord. */
     xxa[i][0] += atan2(sinnode, cosnode);
     swi_polcart(xxa[i], xxa[i]);
+    /* perigee, the same way */
+    xxp[i][0] = swi_mod2PI(uu - ny);
+    xxp[i][1] = 0;
+    xxp[i][2] = sema * (1 - ecce);
+    swi_polcart(xxp[i], xxp[i]);
+    swi_coortrf2(xxp[i], xxp[i], -sinincl, cosincl);
+    swi_cartpol(xxp[i], xxp[i]);
+    xxp[i][0] += atan2(sinnode, cosnode);
+    swi_polcart(xxp[i], xxp[i]);
     /* new distance of node from orbital ellipse:
      * true anomaly of node: */
     ny = swi_mod2PI(ny - uu);
@@ -4960,6 +5507,14 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
       ndap->x[i+3] = 0;
     ndap->teval = tjd;
     ndap->iephe = epheflag;
+    /* perigee */
+    ndpp->x[i] = xxp[2][i];
+    if (iflag & SEFLG_SPEED)
+      ndpp->x[i+3] = (xxp[1][i] - xxp[0][i]) / speed_intv / 2;
+    else
+      ndpp->x[i+3] = 0;
+    ndpp->teval = tjd;
+    ndpp->iephe = epheflag;
     /* node */
     ndnp->x[i] = xx[2][i];
     if (iflag & SEFLG_SPEED)
@@ -4974,12 +5529,14 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
    * light-time is already contained in lunar positions.
    * now compute polar and equatorial coordinates:
    **********************************************************************/
-  for (j = 0; j <= 1; j++) {
+  for (j = 0; j <= 2; j++) {
     double x[6];
     if (j == 0) 
       ndp = &swed.nddat[SEI_TRUE_NODE];
-    else
+    else if (j == 1)
       ndp = &swed.nddat[SEI_OSCU_APOG];
+    else
+      ndp = &swed.nddat[SEI_OSCU_PERG];
     memset((void *) ndp->xreturn, 0, 24 * sizeof(double));
     /* cartesian ecliptic */
     for (i = 0; i <= 5; i++) 
@@ -5087,6 +5644,97 @@ static int lunar_osc_elem(double tjd, int ipl, int32 iflag, char *serr)
   return OK;
 }
 
+/* Chebyshew interpolation of the interpolated apsis ipl over the window 
+ * of f and INTP_FIT_MARGIN days on either side, at INTP_FIT_NCOEF_APOG or 
+ * _PERG nodes. The fit is checked halfway between the nodes and at both 
+ * ends; if it misses by more than INTP_FIT_MAXERR_APOG or _PERG in 
+ * longitude or latitude, f->ncoef is 0 and the window is computed 
+ * exactly. */
+static void intp_apsides_make_fit(struct intp_fit *f, int ipl)
+{
+  double y[3][INTP_FIT_NCOEF_PERG], pol[3];
+  double dt = INTP_FIT_DAYS / 2.0 + INTP_FIT_MARGIN, tmid = f->tbeg + INTP_FIT_DAYS / 2.0;
+  double maxerr, xk, sum;
+  int j, k, m, n;
+  if (ipl == SEI_INTP_APOG) {
+    n = INTP_FIT_NCOEF_APOG;
+    maxerr = INTP_FIT_MAXERR_APOG;
+  } else {
+    n = INTP_FIT_NCOEF_PERG;
+    maxerr = INTP_FIT_MAXERR_PERG;
+  }
+  for (k = 0; k < n; k++) {
+    swi_intp_apsides(tmid + dt * cos(PI * (k + 0.5) / n), pol, ipl);
+    /* continuous longitude */
+    if (k > 0)
+      pol[0] = y[0][0] + swe_difrad2n(pol[0], y[0][0]);
+    for (m = 0; m < 3; m++)
+      y[m][k] = pol[m];
+  }
+  for (m = 0; m < 3; m++) {
+    for (j = 0; j < n; j++) {
+      sum = 0;
+      for (k = 0; k < n; k++)
+        sum += y[m][k] * cos(PI * j * (k + 0.5) / n);
+      f->coef[m][j] = sum * 2 / n;
+    }
+  }
+  f->ncoef = n;
+  for (k = 0; k <= n; k++) {
+    xk = cos(PI * k / n);
+    swi_intp_apsides(tmid + dt * xk, pol, ipl);
+    if (fabs(swe_difrad2n(swi_echeb(xk, f->coef[0], n), pol[0])) * RADTODEG * 3600 > maxerr
+      || fabs(swi_echeb(xk, f->coef[1], n) - pol[1]) * RADTODEG * 3600 > maxerr) {
+      f->ncoef = 0;
+      break;
+    }
+  }
+}
+
+/* swi_intp_apsides() evaluates the lunar theory 15 to 18 times, and 
+ * intp_apsides() calls it three times for the speed. Positions come from 
+ * a chebyshew fit over the window of INTP_FIT_DAYS days of tjd (see 
+ * intp_apsides_make_fit()), which serves all dates in it. The first date 
+ * of a window pays for the fit, but every date is computed the same way, 
+ * whatever was asked for before. Returns the fit, or NULL if the window 
+ * has to be computed exactly. */
+static struct intp_fit *intp_apsides_window(double tjd, int ipl)
+{
+  struct intp_cache *ic = &swed.intpc[ipl - SEI_INTP_APOG];
+  struct intp_fit *f;
+  double tbeg = floor(tjd / INTP_FIT_DAYS) * INTP_FIT_DAYS;
+  int i;
+  for (i = 0; i < ic->nfit; i++) {
+    if (ic->fit[i].tbeg == tbeg)
+      break;
+  }
+  if (i < ic->nfit) {
+    f = &ic->fit[i];
+  } else {
+    f = &ic->fit[ic->ifit];
+    f->tbeg = tbeg;
+    intp_apsides_make_fit(f, ipl);
+    ic->ifit = (ic->ifit + 1) % INTP_NFIT;
+    if (ic->nfit < INTP_NFIT)
+      ic->nfit++;
+  }
+  return f->ncoef > 0 ? f : NULL;
+}
+
+/* position of interpolated apsis ipl at t, from fit f if there is one */
+static void intp_apsides_pol(double t, double *pol, struct intp_fit *f, int ipl)
+{
+  double x;
+  if (f == NULL) {
+    swi_intp_apsides(t, pol, ipl);
+    return;
+  }
+  x = (t - f->tbeg - INTP_FIT_DAYS / 2.0) / (INTP_FIT_DAYS / 2.0 + INTP_FIT_MARGIN);
+  pol[0] = swi_mod2PI(swi_echeb(x, f->coef[0], f->ncoef));
+  pol[1] = swi_echeb(x, f->coef[1], f->ncoef);
+  pol[2] = swi_echeb(x, f->coef[2], f->ncoef);
+}
+
 /* lunar osculating elements, i.e.
  */ 
 static int intp_apsides(double tjd, int ipl, int32 iflag, char *serr) 
@@ -5101,6 +5749,7 @@ static int intp_apsides(double tjd, int ipl, int32 iflag, char *serr)
   double t, dt;
   double xpos[3][6], xx[6], x[6];
   int32 speedf1, speedf2;
+  struct intp_fit *f;
   oe = &swed.oec;
   nut = &swed.nut;
   ndp = &swed.nddat[ipl];
@@ -5121,9 +5770,10 @@ static int intp_apsides(double tjd, int ipl, int32 iflag, char *serr)
   /*********************************************
    * now three apsides * 
    *********************************************/
+  f = intp_apsides_window(tjd, ipl);
   for (t = tjd - speed_intv, i = 0; i < 3; t += speed_intv, i++) {
     if (! (iflag & SEFLG_SPEED) && i != 1) continue;
-    swi_intp_apsides(t, xpos[i], ipl);
+    intp_apsides_pol(t, xpos[i], f, ipl);
   }
   /************************************************************
    * apsis with speed                                         * 
@@ -5248,6 +5898,12 @@ static int intp_apsides(double tjd, int ipl, int32 iflag, char *serr)
  * serr         error string
  */
 int swi_plan_for_osc_elem(int32 iflag, double tjd, double *xx)
+{
+  return plan_for_osc_elem(iflag, tjd, xx, NULL);
+}
+
+/* nutlo, if not NULL, is the nutation of tjd, if it is not in swed */
+static int plan_for_osc_elem(int32 iflag, double tjd, double *xx, double *nutlo)
 {
   int i;
   double x[6];
@@ -5305,7 +5961,12 @@ int swi_plan_for_osc_elem(int32 iflag, double tjd, double *xx)
       nutp = &swed.nutv;
     } else {
       nutp = &nuttmp;
-      swi_nutation(tjd, iflag, nutp->nutlo);
+      if (nutlo != NULL) {
+        nutp->nutlo[0] = nutlo[0];
+        nutp->nutlo[1] = nutlo[1];
+      } else {
+        swi_nutation(tjd, iflag, nutp->nutlo);
+      }
       nutp->tnut = tjd;
       nutp->snut = sin(nutp->nutlo[1]);
       nutp->cnut = cos(nutp->nutlo[1]);
@@ -5513,6 +6174,7 @@ void swi_check_ecliptic(double tjd, int32 iflag)
     return;
   }
   if (swed.oec.teps != tjd || tjd == 0) {
+    SWI_STATS_ADD(SE_STAT_OBLIQUITY, 1);
     calc_epsilon(tjd, iflag, &swed.oec);
   }
 }
@@ -5524,12 +6186,28 @@ void swi_check_nutation(double tjd, int32 iflag)
 {
   int32 speedf1, speedf2;
   static TLS int32 nutflag = 0;
+  int32 flag;
   double t;
+  struct nut nuttmp;
   speedf1 = nutflag & SEFLG_SPEED;
   speedf2 = iflag & SEFLG_SPEED;
   if (!(iflag & SEFLG_NONUT)
 	&& (tjd != swed.nut.tnut || tjd == 0
 	|| (!speedf1 && speedf2))) {
+    /* computations that alternate between two dates, e.g. a position and 
+     * its light-time corrected counterpart in swe_pheno(), find the 
+     * nutation of the other date in the second slot */
+    if (tjd != 0 && tjd == swed.nutprev.tnut 
+	&& ((swed.nutprevflag & SEFLG_SPEED) || !speedf2)) {
+      nuttmp = swed.nut; swed.nut = swed.nutprev; swed.nutprev = nuttmp;
+      nuttmp = swed.nutv; swed.nutv = swed.nutvprev; swed.nutvprev = nuttmp;
+      flag = nutflag; nutflag = swed.nutprevflag; swed.nutprevflag = flag;
+      return;
+    }
+    swed.nutprev = swed.nut;
+    swed.nutvprev = swed.nutv;
+    swed.nutprevflag = nutflag;
+    SWI_STATS_ADD(SE_STAT_NUTATION, 1);
     swi_nutation(tjd, iflag, swed.nut.nutlo);
     swed.nut.tnut = tjd;
     swed.nut.snut = sin(swed.nut.nutlo[1]);
@@ -5649,7 +6327,7 @@ static int32 plaus_iflag(int32 iflag, int32 ipl, double tjd, char *serr)
  * x		pointer for returning the ecliptic coordinates
  * serr		error return string
 **********************************************************/
-int32 swe_fixstar(char *star, double tjd, int32 iflag, 
+static int32 do_fixstar(char *star, double tjd, int32 iflag, 
   double *xx, char *serr)
 {
   int i;
@@ -5777,6 +6455,7 @@ int32 swe_fixstar(char *star, double tjd, int32 iflag,
       }
     }
   }
+  SWI_STATS_ADD(SE_STAT_STAR_SCANS, 1);
   rewind(swed.fixfp);
   while (fgets(s, AS_MAXCH, swed.fixfp) != NULL) {
     fline++;	
@@ -6122,6 +6801,15 @@ if (0) {
   return retc;
 }
 
+int32 swe_fixstar(char *star, double tjd, int32 iflag, 
+  double *xx, char *serr)
+{
+  int32 retc;
+  SWI_STATS_TIMED(SE_STAT_TIME_FIXSTAR, 
+    retc = do_fixstar(star, tjd, iflag, xx, serr));
+  return retc;
+}
+
 int32 swe_fixstar_ut(char *star, double tjd_ut, int32 iflag, 
   double *xx, char *serr)
 {
@@ -6186,6 +6874,7 @@ int32 swe_fixstar_mag(char *star, double *mag, char *serr)
       }
     }
   }
+  SWI_STATS_ADD(SE_STAT_STAR_SCANS, 1);
   rewind(swed.fixfp);
   strncpy(sstar, star, SE_MAX_STNAME);
   sstar[SE_MAX_STNAME] = '\0';
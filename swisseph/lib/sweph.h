@@ -159,8 +159,9 @@
 #define SEI_OSCU_APOG   3
 #define SEI_INTP_APOG   4
 #define SEI_INTP_PERG   5
+#define SEI_OSCU_PERG   6	/* no body number, see swe_lunar_osc_elem() */
 
-#define SEI_NNODE_ETC    6
+#define SEI_NNODE_ETC    7
 
 #define SEI_FLG_HELIO   1
 #define SEI_FLG_ROTATE  2
@@ -464,6 +465,10 @@ extern int swi_osc_el_plan(double tjd, double *xp, int ipl, int ipli, double *xe
 extern FILE *swi_fopen(int ifno, char *fname, char *ephepath, char *serr);
 extern int32 swi_init_swed_if_start(void);
 extern int32 swi_set_tid_acc(double tjd_ut, int32 iflag, int32 denum, char *serr);
+extern void swi_heliacal_cache_open(void);
+extern void swi_heliacal_cache_close(void);
+extern double swi_refrac_extended(double inalt, double geoalt, double atpress, double attemp, double lapse_rate, int32 calc_flag, double *dret);
+extern void swi_move_dpsi_deps_window(double tjd);
 extern int32 swi_get_tid_acc(double tjd_ut, int32 iflag, int32 denum, int32 *denumret, double *tid_acc, char *serr);
 
 /* nutation */
@@ -474,6 +479,59 @@ struct nut {
   double matrix[3][3];	
 };
 
+/* ayanamsas of the true star modes, see aya_true_star() in sweph.c */
+#define AYA_FIT_DAYS	32	/* length of the windows */
+#define AYA_FIT_NCOEF	12	/* chebyshew coefficients per window */
+#define AYA_FIT_MAXERR	0.0001	/* largest error of a fit, arcsec */
+#define AYA_NFIT	4	/* windows kept */
+struct aya_fit {
+  double tbeg;		/* start of window */
+  int32 sid_mode, iflag;
+  int32 retflag;	/* of swe_get_ayanamsa_ex(), or -1 if the window 
+			 * could not be fitted */
+  double coef[AYA_FIT_NCOEF];
+};
+
+struct aya_cache {
+  double tjd;		/* last date computed exactly */
+  int32 sid_mode, iflag, retflag;
+  double daya;
+  int nfit, ifit;
+  struct aya_fit fit[AYA_NFIT];
+};
+
+/* interpolated lunar apsides, see intp_apsides() in sweph.c */
+#define INTP_FIT_DAYS	32	/* length of the windows */
+#define INTP_FIT_MARGIN	0.1	/* fits reach this far beyond a window, 
+				 * for the speed */
+#define INTP_FIT_NCOEF_APOG	16	/* chebyshew coefficients per window */
+#define INTP_FIT_NCOEF_PERG	32	/* the perigee is less smooth */
+#define INTP_FIT_MAXERR_APOG	0.0001	/* largest error of a fit, arcsec */
+#define INTP_FIT_MAXERR_PERG	0.01	/* the iteration in swi_intp_apsides() 
+					 * itself is noisy by 0.005" */
+#define INTP_NFIT	4	/* windows kept per apsis */
+struct intp_fit {
+  double tbeg;		/* start of window */
+  int ncoef;		/* 0 if the window could not be fitted */
+  double coef[3][INTP_FIT_NCOEF_PERG];	/* longitude, latitude, distance */
+};
+
+struct intp_cache {
+  int nfit, ifit;
+  struct intp_fit fit[INTP_NFIT];
+};
+
+/* lunar positions from which lunar_osc_elem() in sweph.c derives the 
+ * osculating elements; they serve all output flags of the same date */
+struct osc_moon {
+  double tjd;
+  int32 iflag;		/* flags of the request the positions depend on */
+  int32 epheflag;	/* ephemeris used */
+  int istart;		/* 0 with speed, 2 without */
+  double speed_intv;
+  double xpos[3][6];
+};
+
 struct plantbl {
   char max_harmonic[9];
   char max_power_of_t;
@@ -549,6 +607,33 @@ struct sid_data {
 
 /* dpsi and deps loaded for 100 years after 1962 */
 #define SWE_DATA_DPSI_DEPS  36525   
+/* days of dpsi and deps kept in bounded memory mode, see swe_set_memory_limit() */
+#define SWE_DATA_DPSI_DEPS_WIN  1024
+
+/* counters and timers of swe_get_stats(). They are only updated if the
+ * library is compiled with SWE_STATS defined; otherwise the macros below
+ * compile to nothing. */
+struct stats_data {
+  double count[SE_NSTAT_COUNTERS];
+  double calls[SE_NSTAT_TIMERS];
+  double seconds[SE_NSTAT_TIMERS];
+  int depth[SE_NSTAT_TIMERS];	/* timed calls in progress */
+};
+
+#ifdef SWE_STATS
+# define SWI_STATS_ADD(i, n)	(swed.stats.count[i] += (n))
+# define SWI_STATS_BEGIN(i)	double swi_stats_t0 = swi_stats_begin(i)
+# define SWI_STATS_END(i)	swi_stats_end(i, swi_stats_t0)
+# define SWI_STATS_TIMED(i, stmt) \
+	do { SWI_STATS_BEGIN(i); stmt; SWI_STATS_END(i); } while (0)
+#else
+# define SWI_STATS_ADD(i, n)
+# define SWI_STATS_BEGIN(i)
+# define SWI_STATS_END(i)
+# define SWI_STATS_TIMED(i, stmt)	stmt
+#endif
+extern double swi_stats_begin(int i);
+extern void swi_stats_end(int i, double t0);
 
 /* if this is changed, then also update initialisation in sweph.c */
 struct swe_data {
@@ -584,6 +669,12 @@ struct swe_data {
   struct nut nut;
   struct nut nut2000;
   struct nut nutv;
+  struct nut nutprev;	/* nutation of the date before, see swi_check_nutation() */
+  struct nut nutvprev;
+  int32 nutprevflag;
+  struct aya_cache ayac;
+  struct intp_cache intpc[2];	/* SEI_INTP_APOG, SEI_INTP_PERG */
+  struct osc_moon oscm;
   struct topo_data topd;
   struct sid_data sidd;
   char astelem[AS_MAXCH * 2];
@@ -596,8 +687,12 @@ struct swe_data {
   //double deps[36525];
   double *dpsi;
   double *deps;
+  AS_BOOL eop_windowed;	/* only SWE_DATA_DPSI_DEPS_WIN days are in memory */
+  double eop_tjd_win;	/* date of dpsi[0] and deps[0] if eop_windowed */
+  int eop_nwin;		/* number of days in the window */
   int32 astro_models[SEI_NMODELS];
   int32 timeout;
+  struct stats_data stats;
 };
 
 extern TLS struct swe_data swed;
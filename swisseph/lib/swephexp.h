@@ -420,6 +420,8 @@ extern "C" {
 #define SE_SCOTOPIC_FLAG		1
 #define SE_MIXEDOPIC_FLAG		2
 
+#define SE_VISLIM_GRID_NVAL		5	/* values per point of swe_vis_limit_mag_grid() */
+
 /* for swe_set_tid_acc() and ephemeris-dependent delta t:
  * intrinsic tidal acceleration in the mean motion of the moon,
  * not given in the parameters list of the ephemeris files but computed
@@ -534,6 +536,27 @@ extern "C" {
 #define SEMOD_DELTAT_STEPHENSON_MORRISON_2004   2
 #define SEMOD_DELTAT_DEFAULT   SEMOD_DELTAT_ESPENAK_MEEUS_2006
 
+/* counters of swe_get_stats() */
+#define SE_STAT_SEGMENTS        0  /* ephemeris segments read, get_new_segment() */
+#define SE_STAT_FILE_OPENS      1  /* files opened, swi_fopen() */
+#define SE_STAT_READ_BYTES      2  /* bytes read from ephemeris files */
+#define SE_STAT_NUTATION        3  /* nutations computed, swi_check_nutation() */
+#define SE_STAT_OBLIQUITY       4  /* obliquities computed, swi_check_ecliptic() */
+#define SE_STAT_SAVED_HITS      5  /* swe_calc() results taken from the save area */
+#define SE_STAT_STAR_SCANS      6  /* searches through the fixed stars file */
+#define SE_STAT_RISE_STEPS      7  /* positions computed by rise, set and transit searches */
+#define SE_STAT_ECLIPSE_STEPS   8  /* conjunctions tried by eclipse and occultation searches */
+#define SE_NSTAT_COUNTERS       9
+/* timers of swe_get_stats(); time of nested calls counts for the outermost one */
+#define SE_STAT_TIME_CALC       0  /* swe_calc(), swe_calc_ut() */
+#define SE_STAT_TIME_SEGMENTS   1  /* get_new_segment(), i.e. ephemeris file reads */
+#define SE_STAT_TIME_FIXSTAR    2  /* swe_fixstar(), swe_fixstar_ut() */
+#define SE_STAT_TIME_HOUSES     3  /* swe_houses(), swe_houses_ex() */
+#define SE_STAT_TIME_RISE_TRANS 4  /* swe_rise_trans(), swe_rise_trans_true_hor() */
+#define SE_STAT_TIME_ECLIPSE    5  /* eclipse and occultation searches */
+#define SE_STAT_TIME_HELIACAL   6  /* swe_heliacal_ut() */
+#define SE_NSTAT_TIMERS         7
+
 /**************************************************************
  * here follow some ugly definitions which are only required
  * if SwissEphemeris is compiled on Windows, either to use a DLL
@@ -588,6 +611,7 @@ extern "C" {
 ext_def(int32) swe_heliacal_ut(double tjdstart_ut, double *geopos, double *datm, double *dobs, char *ObjectName, int32 TypeEvent, int32 iflag, double *dret, char *serr);
 ext_def(int32) swe_heliacal_pheno_ut(double tjd_ut, double *geopos, double *datm, double *dobs, char *ObjectName, int32 TypeEvent, int32 helflag, double *darr, char *serr);
 ext_def(int32) swe_vis_limit_mag(double tjdut, double *geopos, double *datm, double *dobs, char *ObjectName, int32 helflag, double *dret, char *serr);
+ext_def(int32) swe_vis_limit_mag_grid(double tjdut, double *geopos, double *datm, double *dobs, int32 helflag, int32 npoints, double *dazialt, double *dret, char *serr);
 
 /* the following are secret, for Victor Reijs' */
 ext_def(int32) swe_heliacal_angle(double tjdut, double *dgeo, double *datm, double *dobs, int32 helflag, double mag, double azi_obj, double azi_sun, double azi_moon, double alt_moon, double *dret, char *serr);
@@ -612,6 +636,12 @@ ext_def( int32 ) swe_calc(
 ext_def(int32) swe_calc_ut(double tjd_ut, int32 ipl, int32 iflag, 
 	double *xx, char *serr);
 
+ext_def(int32) swe_lunar_osc_elem(double tjd_et, int32 iflag, 
+	double *xnode, double *xapog, double *xperg, char *serr);
+
+ext_def(int32) swe_lunar_osc_elem_ut(double tjd_ut, int32 iflag, 
+	double *xnode, double *xapog, double *xperg, char *serr);
+
 /* fixed stars */
 ext_def( int32 ) swe_fixstar(
         char *star, double tjd, int32 iflag, 
@@ -632,6 +662,16 @@ ext_def( void ) swe_set_ephe_path(char *path);
 /* set file name of JPL file */
 ext_def( void ) swe_set_jpl_file(char *fname);
 
+/* limit the memory of the calling thread for ephemeris data */
+ext_def( void ) swe_set_memory_limit(int32 nbytes);
+
+/* memory of the calling thread for ephemeris data */
+ext_def( int32 ) swe_get_memory_stats(int32 *stats);
+
+/* hot path counters and timers of the calling thread */
+ext_def( int32 ) swe_get_stats(double *counters, double *timers);
+ext_def( void ) swe_reset_stats(void);
+
 /* get planet name */
 ext_def( char *) swe_get_planet_name(int ipl, char *spname);
 
@@ -815,6 +855,14 @@ ext_def (int32) swe_nod_aps_ut(double tjd_ut, int32 ipl, int32 iflag,
                       double *xperi, double *xaphe, 
                       char *serr);
 
+ext_def (int32) swe_nod_aps_batch(double tjd_et, int32 *ipl, int32 nipl, 
+                      int32 iflag, int32 *method, int32 nmeth, 
+                      double *xret, char *serr);
+
+ext_def (int32) swe_nod_aps_batch_ut(double tjd_ut, int32 *ipl, int32 nipl, 
+                      int32 iflag, int32 *method, int32 nmeth, 
+                      double *xret, char *serr);
+
 
 /**************************** 
  * exports from swephlib.c 
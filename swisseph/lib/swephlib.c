@@ -1706,7 +1706,7 @@ done:
 int swi_nutation(double J, int32 iflag, double *nutlo)
 {
   int n;
-  double dpsi, deps, J2;
+  double dpsi, deps, J2, tjd0;
   int nut_model = swed.astro_models[SE_MODEL_NUT];
   int jplhor_model = swed.astro_models[SE_MODEL_JPLHOR_MODE];
   int jplhora_model = swed.astro_models[SE_MODEL_JPLHORA_MODE];
@@ -1728,12 +1728,19 @@ int swi_nutation(double J, int32 iflag, double *nutlo)
     }
   }
   if ((iflag & SEFLG_JPLHOR)/* && INCLUDE_CODE_FOR_DPSI_DEPS_IAU1980*/) {
-    n = (int) (swed.eop_tjd_end - swed.eop_tjd_beg + 0.000001);
+    n = (int) (swed.eop_tjd_end - swed.eop_tjd_beg + 0.000001) + 1;
+    tjd0 = swed.eop_tjd_beg;
     J2 = J;
     if (J < swed.eop_tjd_beg_horizons)
       J2 = swed.eop_tjd_beg_horizons;
-    dpsi = bessel(swed.dpsi, n + 1, J2 - swed.eop_tjd_beg);
-    deps = bessel(swed.deps, n + 1, J2 - swed.eop_tjd_beg);
+    /* bounded memory mode: only a window of the days is in memory */
+    if (swed.eop_windowed) {
+      swi_move_dpsi_deps_window(J2);
+      n = swed.eop_nwin;
+      tjd0 = swed.eop_tjd_win;
+    }
+    dpsi = bessel(swed.dpsi, n, J2 - tjd0);
+    deps = bessel(swed.deps, n, J2 - tjd0);
     nutlo[0] += dpsi / 3600.0 * DEGTORAD;
     nutlo[1] += deps / 3600.0 * DEGTORAD;
 #if 0
@@ -3357,6 +3364,10 @@ void swe_set_astro_models(int32 *imodel)
   int *pmodel = &(swed.astro_models[0]);
   swi_init_swed_if_start();
   memcpy(pmodel, imodel, SEI_NMODELS * sizeof(int32));
+  /* fits of the true star ayanamsas depend on the models */
+  memset((void *) &swed.ayac, 0, sizeof(struct aya_cache));
+  /* so do the lunar positions for the osculating elements */
+  memset((void *) &swed.oscm, 0, sizeof(struct osc_moon));
 }
 
 #if 0
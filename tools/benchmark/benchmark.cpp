@@ -0,0 +1,448 @@
+// Throughput and latency of the library's hot entry points, built for the
+// host without React Native (see CMakeLists.txt next to this file).
+//
+//   swisseph_benchmark [--ephe-path <dir>] [--output <file>] [--time <seconds>] [--filter <text>]
+//
+// Every case makes one warm-up call, then calls the function for about
+// --time seconds (at least kMinCalls times) and reports calls per second and
+// percentiles of the per-call latency. A case whose warm-up call fails, e.g.
+// a fixed star without sefstars.txt in the ephemeris path, is reported with
+// its error and not measured. Inputs come from fixed seeds, so two
+// builds measure the same work and their JSON can be compared case by case.
+// --filter keeps the cases whose label ("calc/swe_calc_ut/Moon/SWIEPH/random",
+// printed on stderr while running) contains the text. Built with
+// SWISSEPH_STATS=ON, each case also reports the non-zero counters and timers
+// of swe_get_stats() over its measured calls.
+#include "RNSwisseph.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr long kMinCalls = 3;
+constexpr long kMaxCalls = 1000000;
+constexpr size_t kInputs = 4096; /* dates and places per case, cycled */
+
+struct Options {
+  std::string ephePath = SWISSEPH_BENCH_EPHE_PATH;
+  std::string output;
+  double seconds = 0.2;
+  std::string filter;
+};
+
+std::string jsonString(const std::string &s) {
+  std::string out = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      out += buf;
+    } else {
+      out += c;
+    }
+  }
+  return out + "\"";
+}
+
+std::string jsonNumber(double x) {
+  if (!std::isfinite(x)) {
+    return "null";
+  }
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.6g", x);
+  return buf;
+}
+
+// Case parameters; values are JSON already.
+typedef std::vector<std::pair<std::string, std::string>> Params;
+
+struct Result {
+  std::string group, function;
+  Params params;
+  long calls = 0;
+  long errors = 0;
+  bool skipped = false;
+  double seconds = 0;
+  std::vector<double> latency; /* microseconds, sorted */
+  std::string error;           /* message of the first failing call */
+  std::map<std::string, double> stats; /* swe_get_stats() of the measured calls */
+};
+
+double percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.empty()) {
+    return NAN;
+  }
+  size_t i = static_cast<size_t>(std::ceil(p * sorted.size()));
+  return sorted[std::min(sorted.size() - 1, i > 0 ? i - 1 : 0)];
+}
+
+class Runner {
+ public:
+  explicit Runner(const Options &opt) : opt_(opt) {}
+
+  // Runs fn(i, serr) repeatedly, i counting calls from 0; a negative return
+  // value counts as an error. Skipped if the label does not match --filter.
+  template <typename Fn>
+  void run(const std::string &group, const std::string &function, const Params &params, Fn fn) {
+    std::string label = group + "/" + function;
+    for (const auto &p : params) {
+      std::string v = p.second;
+      v.erase(std::remove(v.begin(), v.end(), '"'), v.end());
+      label += "/" + v;
+    }
+    if (!opt_.filter.empty() && label.find(opt_.filter) == std::string::npos) {
+      return;
+    }
+    Result r;
+    r.group = group;
+    r.function = function;
+    r.params = params;
+    char serr[AS_MAXCH] = "";
+    // warm-up: opens files and fills the caches a long running app has
+    if (fn(0, serr) < 0) {
+      r.error = serr;
+      r.skipped = true;
+      fprintf(stderr, "%-60s skipped: %s\n", label.c_str(), serr);
+      results_.push_back(std::move(r));
+      return;
+    }
+    swisseph::swe_reset_stats();
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now(), last = start;
+    while (r.calls < kMaxCalls && (r.calls < kMinCalls || r.seconds < opt_.seconds)) {
+      serr[0] = '\0';
+      int32 ret = fn(r.calls + 1, serr);
+      Clock::time_point now = Clock::now();
+      if (ret < 0) {
+        if (r.error.empty()) {
+          r.error = serr;
+        }
+        r.errors++;
+      }
+      r.latency.push_back(std::chrono::duration<double, std::micro>(now - last).count());
+      r.seconds = std::chrono::duration<double>(now - start).count();
+      r.calls++;
+      last = now;
+    }
+    std::sort(r.latency.begin(), r.latency.end());
+    r.stats = swisseph::swe_get_stats();
+    fprintf(stderr, "%-60s %10.0f calls/s %10.2f us p50\n", label.c_str(), r.calls / r.seconds, percentile(r.latency, 0.5));
+    results_.push_back(std::move(r));
+  }
+
+  std::string json() const {
+    char version[AS_MAXCH];
+    ::swe_version(version);
+    char stamp[32];
+    time_t now = time(NULL);
+    strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    std::string s = "{\n";
+    s += "  \"library\": " + jsonString(version) + ",\n";
+#if defined(__VERSION__)
+    s += "  \"compiler\": " + jsonString(__VERSION__) + ",\n";
+#endif
+    s += "  \"buildType\": " + jsonString(SWISSEPH_BENCH_BUILD_TYPE) + ",\n";
+    s += "  \"ephePath\": " + jsonString(opt_.ephePath) + ",\n";
+    s += "  \"secondsPerCase\": " + jsonNumber(opt_.seconds) + ",\n";
+    s += "  \"timestamp\": " + jsonString(stamp) + ",\n";
+    s += "  \"results\": [";
+    for (size_t i = 0; i < results_.size(); i++) {
+      const Result &r = results_[i];
+      s += i ? ",\n    {" : "\n    {";
+      s += "\"group\": " + jsonString(r.group) + ", \"function\": " + jsonString(r.function) + ", \"params\": {";
+      for (size_t k = 0; k < r.params.size(); k++) {
+        s += (k ? ", " : "") + jsonString(r.params[k].first) + ": " + r.params[k].second;
+      }
+      s += "}, \"calls\": " + std::to_string(r.calls);
+      if (r.skipped) {
+        s += ", \"skipped\": true, \"error\": " + jsonString(r.error) + "}";
+        continue;
+      }
+      s += ", \"errors\": " + std::to_string(r.errors);
+      s += ", \"seconds\": " + jsonNumber(r.seconds);
+      s += ", \"callsPerSecond\": " + jsonNumber(r.calls / r.seconds);
+      double mean = r.seconds * 1e6 / r.calls;
+      s += ", \"latencyUs\": {\"mean\": " + jsonNumber(mean) + ", \"p50\": " + jsonNumber(percentile(r.latency, 0.5)) +
+           ", \"p90\": " + jsonNumber(percentile(r.latency, 0.9)) + ", \"p99\": " + jsonNumber(percentile(r.latency, 0.99)) +
+           ", \"max\": " + jsonNumber(r.latency.empty() ? NAN : r.latency.back()) + "}";
+      if (!r.error.empty()) {
+        s += ", \"error\": " + jsonString(r.error);
+      }
+      if (r.stats.at("enabled")) {
+        std::string stats;
+        for (const auto &kv : r.stats) {
+          if (kv.first != "enabled" && kv.second != 0) {
+            stats += (stats.empty() ? "" : ", ") + jsonString(kv.first) + ": " + jsonNumber(kv.second);
+          }
+        }
+        s += ", \"stats\": {" + stats + "}";
+      }
+      s += "}";
+    }
+    s += "\n  ]\n}\n";
+    return s;
+  }
+
+ private:
+  const Options &opt_;
+  std::vector<Result> results_;
+};
+
+// Julian days (UT) drawn uniformly from [tjd_start, tjd_end).
+std::vector<double> randomDates(double tjd_start, double tjd_end, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(tjd_start, tjd_end);
+  std::vector<double> v(kInputs);
+  for (auto &t : v) {
+    t = dist(gen);
+  }
+  return v;
+}
+
+// Consecutive days, the pattern of charts and tables for a period.
+std::vector<double> dailyDates(double tjd_start) {
+  std::vector<double> v(kInputs);
+  for (size_t i = 0; i < kInputs; i++) {
+    v[i] = tjd_start + i;
+  }
+  return v;
+}
+
+const char *ephemerisName(int32 flag) {
+  return (flag & SEFLG_MOSEPH) ? "MOSEPH" : "SWIEPH";
+}
+
+Params params(std::initializer_list<std::pair<std::string, std::string>> list) {
+  return Params(list);
+}
+
+void benchCalc(Runner &runner) {
+  // the se1 files in assets/ cover 1800 to 2400
+  const double j1800 = 2378496.5, j2400 = 2597641.5;
+  std::vector<double> random = randomDates(j1800, j2400, 1);
+  std::vector<double> daily = dailyDates(2451544.5);
+  const int bodies[] = {SE_SUN, SE_MOON, SE_MERCURY, SE_VENUS, SE_MARS, SE_JUPITER, SE_SATURN, SE_URANUS,
+                        SE_NEPTUNE, SE_PLUTO, SE_MEAN_NODE, SE_TRUE_NODE, SE_MEAN_APOG, SE_OSCU_APOG,
+                        SE_INTP_APOG, SE_CHIRON, SE_CERES};
+  for (int32 ephe : {SEFLG_SWIEPH, SEFLG_MOSEPH}) {
+    for (int ipl : bodies) {
+      // asteroids only come from files
+      if (ephe == SEFLG_MOSEPH && (ipl == SE_CHIRON || ipl == SE_CERES)) {
+        continue;
+      }
+      char name[AS_MAXCH];
+      ::swe_get_planet_name(ipl, name);
+      for (const auto *dates : {&random, &daily}) {
+        const std::vector<double> &d = *dates;
+        runner.run("calc", "swe_calc_ut",
+                   params({{"body", jsonString(name)}, {"ipl", std::to_string(ipl)},
+                           {"ephemeris", jsonString(ephemerisName(ephe))},
+                           {"dates", jsonString(dates == &random ? "random" : "daily")}}),
+                   [&](long i, char *serr) {
+                     double xx[6];
+                     return ::swe_calc_ut(d[i % kInputs], ipl, ephe | SEFLG_SPEED, xx, serr);
+                   });
+      }
+    }
+  }
+}
+
+void benchHouses(Runner &runner) {
+  std::vector<double> dates = randomDates(2378496.5, 2597641.5, 2);
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> lon(-180, 180), lat(-60, 60);
+  std::vector<double> lons(kInputs), lats(kInputs);
+  for (size_t i = 0; i < kInputs; i++) {
+    lons[i] = lon(gen);
+    lats[i] = lat(gen);
+  }
+  for (const char *h = "PKORCEBGHMTUVWXY"; *h; h++) {
+    int hsys = *h;
+    runner.run("houses", "swe_houses_ex", params({{"hsys", jsonString(std::string(1, *h))}, {"name", jsonString(::swe_house_name(hsys))}}),
+               [&](long i, char *serr) {
+                 double cusps[37], ascmc[10];
+                 size_t k = i % kInputs;
+                 int32 ret = ::swe_houses_ex(dates[k], SEFLG_SWIEPH, lats[k], lons[k], hsys, cusps, ascmc);
+                 if (ret < 0) {
+                   strcpy(serr, "swe_houses_ex() fell back to Porphyry");
+                 }
+                 return ret;
+               });
+  }
+}
+
+void benchFixstar(Runner &runner) {
+  std::vector<double> dates = randomDates(2378496.5, 2597641.5, 4);
+  // by traditional name and by Bayer designation; both scan sefstars.txt
+  for (const char *star : {"Aldebaran", "Regulus", "Spica", "Sirius", ",alCMa"}) {
+    runner.run("fixstar", "swe_fixstar", params({{"star", jsonString(star)}}), [&](long i, char *serr) {
+      char name[SE_MAX_STNAME * 2 + 1];
+      double xx[6];
+      strcpy(name, star);
+      return ::swe_fixstar(name, dates[i % kInputs] + 0.0008, SEFLG_SWIEPH | SEFLG_SPEED, xx, serr);
+    });
+  }
+}
+
+void benchEclipses(Runner &runner) {
+  // searches start at random dates of the 20th and 21st centuries
+  std::vector<double> dates = randomDates(2415020.5, 2488069.5, 5);
+  double geopos[3] = {8.55, 47.37, 400};
+  runner.run("eclipse", "swe_sol_eclipse_when_glob", params({}), [&](long i, char *serr) {
+    double tret[10];
+    return ::swe_sol_eclipse_when_glob(dates[i % kInputs], SEFLG_SWIEPH, 0, tret, 0, serr);
+  });
+  runner.run("eclipse", "swe_sol_eclipse_when_loc", params({{"geopos", "[8.55, 47.37, 400]"}}), [&](long i, char *serr) {
+    double tret[10], attr[20];
+    return ::swe_sol_eclipse_when_loc(dates[i % kInputs], SEFLG_SWIEPH, geopos, tret, attr, 0, serr);
+  });
+  runner.run("eclipse", "swe_lun_eclipse_when", params({}), [&](long i, char *serr) {
+    double tret[10];
+    return ::swe_lun_eclipse_when(dates[i % kInputs], SEFLG_SWIEPH, 0, tret, 0, serr);
+  });
+  runner.run("eclipse", "swe_lun_occult_when_glob", params({{"body", "\"Venus\""}}), [&](long i, char *serr) {
+    double tret[10];
+    return ::swe_lun_occult_when_glob(dates[i % kInputs], SE_VENUS, NULL, SEFLG_SWIEPH, 0, tret, 0, serr);
+  });
+}
+
+void benchRiseTrans(Runner &runner) {
+  std::vector<double> dates = randomDates(2415020.5, 2488069.5, 6);
+  struct Event {
+    const char *name;
+    int32 rsmi;
+  };
+  const Event events[] = {{"rise", SE_CALC_RISE}, {"set", SE_CALC_SET}, {"mtransit", SE_CALC_MTRANSIT}};
+  for (double lat : {47.37, 65.0}) {
+    double geopos[3] = {8.55, lat, 400};
+    for (int ipl : {SE_SUN, SE_MOON, SE_MARS}) {
+      char name[AS_MAXCH];
+      ::swe_get_planet_name(ipl, name);
+      for (const Event &e : events) {
+        runner.run("rise_trans", "swe_rise_trans",
+                   params({{"body", jsonString(name)}, {"event", jsonString(e.name)}, {"latitude", jsonNumber(lat)}}),
+                   [&](long i, char *serr) {
+                     double tret;
+                     return ::swe_rise_trans(dates[i % kInputs], ipl, NULL, SEFLG_SWIEPH, e.rsmi, geopos, 1013.25, 10, &tret, serr);
+                   });
+      }
+    }
+  }
+}
+
+void benchHeliacal(Runner &runner) {
+  std::vector<double> dates = randomDates(2415020.5, 2488069.5, 7);
+  struct Case {
+    const char *object;
+    int32 event;
+    const char *name;
+  };
+  const Case cases[] = {{"Venus", SE_HELIACAL_RISING, "heliacal rising"},
+                        {"Mercury", SE_EVENING_FIRST, "evening first"},
+                        {"Moon", SE_MORNING_LAST, "morning last"},
+                        {"Sirius", SE_HELIACAL_RISING, "heliacal rising"}};
+  for (const Case &c : cases) {
+    runner.run("heliacal", "swe_heliacal_ut", params({{"object", jsonString(c.object)}, {"event", jsonString(c.name)}}),
+               [&](long i, char *serr) {
+                 double dgeo[3] = {8.55, 47.37, 400};
+                 double datm[4] = {1013.25, 15, 40, 0};
+                 double dobs[6] = {36, 1, 0, 0, 0, 0};
+                 double dret[50];
+                 char object[AS_MAXCH];
+                 strcpy(object, c.object);
+                 return ::swe_heliacal_ut(dates[i % kInputs], dgeo, datm, dobs, object, c.event, SEFLG_SWIEPH, dret, serr);
+               });
+  }
+}
+
+// The same functions through the C++ layer the JSI bindings call, which adds
+// result maps and exceptions on top of the C calls.
+void benchWrappers(Runner &runner) {
+  std::vector<double> dates = randomDates(2378496.5, 2597641.5, 8);
+  auto guarded = [](char *serr, auto call) -> int32 {
+    try {
+      call();
+    } catch (std::exception &e) {
+      strncpy(serr, e.what(), AS_MAXCH - 1);
+      serr[AS_MAXCH - 1] = '\0';
+      return ERR;
+    }
+    return OK;
+  };
+  runner.run("wrapper", "swisseph::swe_calc_ut", params({{"body", "\"Moon\""}}), [&](long i, char *serr) {
+    return guarded(serr, [&]() { swisseph::swe_calc_ut(dates[i % kInputs], SE_MOON, SEFLG_SWIEPH | SEFLG_SPEED); });
+  });
+  runner.run("wrapper", "swisseph::swe_houses", params({{"hsys", "\"P\""}}), [&](long i, char *serr) {
+    return guarded(serr, [&]() { swisseph::swe_houses(dates[i % kInputs], 0, 47.37, 8.55, "P"); });
+  });
+  runner.run("wrapper", "swisseph::swe_fixstar_ut", params({{"star", "\"Spica\""}}), [&](long i, char *serr) {
+    return guarded(serr, [&]() { swisseph::swe_fixstar_ut("Spica", dates[i % kInputs], SEFLG_SWIEPH); });
+  });
+}
+
+bool parseArgs(int argc, char **argv, Options &opt) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    if (arg == "--ephe-path") {
+      opt.ephePath = argv[++i];
+    } else if (arg == "--output") {
+      opt.output = argv[++i];
+    } else if (arg == "--time") {
+      opt.seconds = atof(argv[++i]);
+    } else if (arg == "--filter") {
+      opt.filter = argv[++i];
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parseArgs(argc, argv, opt)) {
+    fprintf(stderr, "usage: %s [--ephe-path <dir>] [--output <file>] [--time <seconds>] [--filter <text>]\n", argv[0]);
+    return 2;
+  }
+  ::swe_set_ephe_path(const_cast<char *>(opt.ephePath.c_str()));
+  Runner runner(opt);
+  benchCalc(runner);
+  benchHouses(runner);
+  benchFixstar(runner);
+  benchEclipses(runner);
+  benchRiseTrans(runner);
+  benchHeliacal(runner);
+  benchWrappers(runner);
+  ::swe_close();
+
+  std::string json = runner.json();
+  FILE *fp = opt.output.empty() ? stdout : fopen(opt.output.c_str(), "w");
+  if (fp == NULL) {
+    fprintf(stderr, "cannot write %s\n", opt.output.c_str());
+    return 1;
+  }
+  fputs(json.c_str(), fp);
+  if (fp != stdout) {
+    fclose(fp);
+  }
+  return 0;
+}
@@ -0,0 +1,34 @@
+// Generates the binary eclipse catalog read by sweEclipseCatalogWhen() and
+// sweEclipseCatalogRange().
+//
+//   eclipse_catalog <output> <start year> <end year> [ephemeris path]
+//
+// Build on the host with the CMake project next to this file:
+//
+//   cmake -S tools/eclipse_catalog -B build/eclipse_catalog
+//   cmake --build build/eclipse_catalog
+//   build/eclipse_catalog/eclipse_catalog eclipses.bin 1900 2100 assets
+//
+// and ship the output next to the ephemeris files.
+#include "RNSwisseph.h"
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+int main(int argc, char **argv) {
+  if (argc < 4) {
+    fprintf(stderr, "usage: %s <output> <start year> <end year> [ephemeris path]\n", argv[0]);
+    return 2;
+  }
+  ::swe_set_ephe_path(argc > 4 ? argv[4] : NULL);
+  double tjd_start = ::swe_julday(atoi(argv[2]), 1, 1, 0, SE_GREG_CAL);
+  double tjd_end = ::swe_julday(atoi(argv[3]), 1, 1, 0, SE_GREG_CAL);
+  try {
+    swisseph::swe_eclipse_catalog_build(argv[1], tjd_start, tjd_end, SEFLG_SWIEPH);
+  } catch (std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  ::swe_close();
+  return 0;
+}